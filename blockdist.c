@@ -0,0 +1,369 @@
+/*
+ * blockdist.c
+ *
+ * Blocked point-to-set minimum distance engine. Tree-based searches degrade to brute
+ * force once the number of objectives grows, so for many-objective sets it pays off to
+ * do the brute force well instead: blocks of both sets are packed (already scaled) into
+ * contiguous buffers, and all the pairwise inner products of a block are computed by a
+ * register-blocked kernel, just like the inner kernel of a matrix product.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "cpudispatch.h"
+#include "blockdist.h"
+
+// Tile sizes: query vectors per block and reference vectors per block
+#define TILE_X 64
+#define TILE_Y 256
+
+/* Relative size of the rounding error of |x|^2 + |y|^2 - 2x.y. Candidates whose
+ * distance falls below this fraction of |x|^2 + |y|^2 are recomputed exactly. */
+#define CANCEL_TOL 1e-9
+
+/* Register-blocked inner product kernel. Computes the inner products of X_ROWS packed
+ * query vectors (row stride vlen) against the ny vectors of a packed reference block,
+ * stored as panels of PANEL vectors in which the k-th components of the vectors of the
+ * panel are contiguous. Each panel is reduced entirely in registers, and the fixed
+ * size inner loops are turned into vector instructions by the compiler. The products
+ * of row r and vector b end up in acc[r*TILE_Y + b]. */
+#define X_ROWS 4
+#define PANEL 4
+#if defined(__GNUC__)
+/* Two-lane vectors (the width every x86-64 processor supports) keep the 4x4 block of
+ * accumulators in registers */
+typedef double v2d __attribute__((vector_size(2*sizeof(double))));
+
+static void dot_kernel(const double *restrict x, const double *restrict Yp, int ny,
+		int vlen, double *restrict acc)
+{
+	int p, k;
+	double xk;
+	v2d s00, s01, s10, s11, s20, s21, s30, s31, y0, y1;
+	const double *restrict pan;
+
+	for (p = 0; p < ny; p += PANEL)
+	{
+		pan = Yp + (size_t)p*vlen;
+		s00 = s01 = s10 = s11 = s20 = s21 = s30 = s31 = (v2d){0, 0};
+		for (k = 0; k < vlen; k++)
+		{
+			__builtin_memcpy(&y0, pan + k*PANEL, sizeof(y0));
+			__builtin_memcpy(&y1, pan + k*PANEL + 2, sizeof(y1));
+			xk = x[k];
+			s00 += xk * y0;
+			s01 += xk * y1;
+			xk = x[vlen + k];
+			s10 += xk * y0;
+			s11 += xk * y1;
+			xk = x[2*vlen + k];
+			s20 += xk * y0;
+			s21 += xk * y1;
+			xk = x[3*vlen + k];
+			s30 += xk * y0;
+			s31 += xk * y1;
+		}
+		__builtin_memcpy(acc + p, &s00, sizeof(s00));
+		__builtin_memcpy(acc + p + 2, &s01, sizeof(s01));
+		__builtin_memcpy(acc + TILE_Y + p, &s10, sizeof(s10));
+		__builtin_memcpy(acc + TILE_Y + p + 2, &s11, sizeof(s11));
+		__builtin_memcpy(acc + 2*TILE_Y + p, &s20, sizeof(s20));
+		__builtin_memcpy(acc + 2*TILE_Y + p + 2, &s21, sizeof(s21));
+		__builtin_memcpy(acc + 3*TILE_Y + p, &s30, sizeof(s30));
+		__builtin_memcpy(acc + 3*TILE_Y + p + 2, &s31, sizeof(s31));
+	}
+}
+
+#if MOO_ISA_VARIANTS
+/* With four-lane vectors, each row of the block takes a single accumulator. The body is
+ * compiled once per instruction set variant; every lane does the same operations in
+ * the same order as in the two-lane kernel, so all of them give the same products. */
+typedef double v4d __attribute__((vector_size(4*sizeof(double))));
+
+static inline __attribute__((always_inline)) void dot_kernel_v4(const double *restrict x,
+		const double *restrict Yp, int ny, int vlen, double *restrict acc)
+{
+	int p, k;
+	v4d s0, s1, s2, s3, y;
+	const double *restrict pan;
+
+	for (p = 0; p < ny; p += PANEL)
+	{
+		pan = Yp + (size_t)p*vlen;
+		s0 = s1 = s2 = s3 = (v4d){0, 0, 0, 0};
+		for (k = 0; k < vlen; k++)
+		{
+			__builtin_memcpy(&y, pan + k*PANEL, sizeof(y));
+			s0 += x[k] * y;
+			s1 += x[vlen + k] * y;
+			s2 += x[2*vlen + k] * y;
+			s3 += x[3*vlen + k] * y;
+		}
+		__builtin_memcpy(acc + p, &s0, sizeof(s0));
+		__builtin_memcpy(acc + TILE_Y + p, &s1, sizeof(s1));
+		__builtin_memcpy(acc + 2*TILE_Y + p, &s2, sizeof(s2));
+		__builtin_memcpy(acc + 3*TILE_Y + p, &s3, sizeof(s3));
+	}
+}
+
+static MOO_TARGET_AVX2 void dot_kernel_avx2(const double *restrict x,
+		const double *restrict Yp, int ny, int vlen, double *restrict acc)
+{
+	dot_kernel_v4(x, Yp, ny, vlen, acc);
+}
+
+static MOO_TARGET_AVX512 void dot_kernel_avx512(const double *restrict x,
+		const double *restrict Yp, int ny, int vlen, double *restrict acc)
+{
+	dot_kernel_v4(x, Yp, ny, vlen, acc);
+}
+#endif
+#else
+static void dot_kernel(const double *restrict x, const double *restrict Yp, int ny,
+		int vlen, double *restrict acc)
+{
+	int p, k, r, j;
+	double s[X_ROWS][PANEL];
+	const double *restrict pan;
+
+	for (p = 0; p < ny; p += PANEL)
+	{
+		pan = Yp + (size_t)p*vlen;
+		for (r = 0; r < X_ROWS; r++)
+			for (j = 0; j < PANEL; j++)
+				s[r][j] = 0;
+		for (k = 0; k < vlen; k++)
+		{
+			for (r = 0; r < X_ROWS; r++)
+				for (j = 0; j < PANEL; j++)
+					s[r][j] += x[r*vlen + k] * pan[k*PANEL + j];
+		}
+		for (r = 0; r < X_ROWS; r++)
+			for (j = 0; j < PANEL; j++)
+				acc[r*TILE_Y + p + j] = s[r][j];
+	}
+}
+#endif
+
+/* Turns the inner products of a query vector into squared distances (in place) and
+ * returns the smallest of them, or bound if none is smaller. Four independent running
+ * minima keep the comparisons from forming a single dependency chain. */
+static inline __attribute__((always_inline)) double min_dists_body(double *restrict dots,
+		const double *restrict ynorm, double xn, int ny, double bound)
+{
+	int b;
+	double d0, d1, d2, d3, m0, m1, m2, m3;
+
+	m0 = m1 = m2 = m3 = bound;
+	for (b = 0; b + 4 <= ny; b += 4)
+	{
+		d0 = xn + ynorm[b] - 2*dots[b];
+		d1 = xn + ynorm[b+1] - 2*dots[b+1];
+		d2 = xn + ynorm[b+2] - 2*dots[b+2];
+		d3 = xn + ynorm[b+3] - 2*dots[b+3];
+		dots[b] = d0;
+		dots[b+1] = d1;
+		dots[b+2] = d2;
+		dots[b+3] = d3;
+		m0 = (d0 < m0) ? d0 : m0;
+		m1 = (d1 < m1) ? d1 : m1;
+		m2 = (d2 < m2) ? d2 : m2;
+		m3 = (d3 < m3) ? d3 : m3;
+	}
+	for (; b < ny; b++)
+	{
+		d0 = xn + ynorm[b] - 2*dots[b];
+		dots[b] = d0;
+		m0 = (d0 < m0) ? d0 : m0;
+	}
+	m0 = (m1 < m0) ? m1 : m0;
+	m2 = (m3 < m2) ? m3 : m2;
+	return (m2 < m0) ? m2 : m0;
+}
+
+static double min_dists(double *restrict dots, const double *restrict ynorm, double xn,
+		int ny, double bound)
+{
+	return min_dists_body(dots, ynorm, xn, ny, bound);
+}
+
+#if MOO_ISA_VARIANTS
+static MOO_TARGET_AVX2 double min_dists_avx2(double *restrict dots,
+		const double *restrict ynorm, double xn, int ny, double bound)
+{
+	return min_dists_body(dots, ynorm, xn, ny, bound);
+}
+
+static MOO_TARGET_AVX512 double min_dists_avx512(double *restrict dots,
+		const double *restrict ynorm, double xn, int ny, double bound)
+{
+	return min_dists_body(dots, ynorm, xn, ny, bound);
+}
+#endif
+
+void block_min_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int flags, double *mindists, int *nearest)
+{
+	int xlen = X->len, ylen = Y->len, vlen = X->vlen;
+	ptrdiff_t xs = X->cstride, ys = Y->cstride;
+	int x0, y0, nx, ny, a, b, k, best;
+	double v, d, xn, bestd, tmin;
+	double *Xp, *Yp, *xnorm, *ynorm, *acc, *dots;
+	const double *row, *xrow, *yrow;
+	int *bestidx;
+	void (*dot)(const double*, const double*, int, int, double*) = &dot_kernel;
+	double (*mins)(double*, const double*, double, int, double) = &min_dists;
+
+#if MOO_ISA_VARIANTS
+	switch (moo_active_isa())
+	{
+		case moo_isa_avx512:
+			dot = &dot_kernel_avx512;
+			mins = &min_dists_avx512;
+			break;
+		case moo_isa_avx2:
+			dot = &dot_kernel_avx2;
+			mins = &min_dists_avx2;
+			break;
+		default:
+			break;
+	}
+#endif
+
+	Xp = checked_malloc(sizeof(double)*(size_t)TILE_X*vlen);
+	for (a = 0; a < TILE_X*vlen; a++)
+		Xp[a] = 0;
+	Yp = checked_malloc(sizeof(double)*(size_t)TILE_Y*vlen);
+	for (b = 0; b < TILE_Y*vlen; b++)
+		Yp[b] = 0;
+	xnorm = checked_malloc(sizeof(double)*TILE_X);
+	ynorm = checked_malloc(sizeof(double)*TILE_Y);
+	acc = checked_malloc(sizeof(double)*(size_t)X_ROWS*TILE_Y);
+	bestidx = new_vector_int(TILE_X);
+
+	for (x0 = 0; x0 < xlen; x0 += TILE_X)
+	{
+		nx = (xlen - x0 < TILE_X) ? (xlen - x0) : TILE_X;
+
+		// Pack (and scale) the query block, row-major
+		for (a = 0; a < nx; a++)
+		{
+			row = frontview_row(X, x0 + a);
+			xn = 0;
+			for (k = 0; k < vlen; k++)
+			{
+				v = scale ? row[k*xs]*scale[k] : row[k*xs];
+				Xp[(size_t)a*vlen + k] = v;
+				xn += v*v;
+			}
+			xnorm[a] = xn;
+			mindists[x0 + a] = DBL_MAX;
+			bestidx[a] = -1;
+		}
+
+		for (y0 = 0; y0 < ylen; y0 += TILE_Y)
+		{
+			ny = (ylen - y0 < TILE_Y) ? (ylen - y0) : TILE_Y;
+
+			// Pack (and scale) the reference block into panels
+			for (b = 0; b < ny; b++)
+			{
+				row = frontview_row(Y, y0 + b);
+				ynorm[b] = 0;
+				for (k = 0; k < vlen; k++)
+				{
+					v = scale ? row[k*ys]*scale[k] : row[k*ys];
+					Yp[((size_t)(b/PANEL)*vlen + k)*PANEL + b%PANEL] = v;
+					ynorm[b] += v*v;
+				}
+			}
+
+			for (a = 0; a < nx; a++)
+			{
+				if (a % X_ROWS == 0)
+					dot(Xp + (size_t)a*vlen, Yp, ny, vlen, acc);
+				dots = acc + (size_t)(a % X_ROWS)*TILE_Y;
+				xn = xnorm[a];
+				bestd = mindists[x0 + a];
+				best = -1;
+				/* Branch-free pass first. Most blocks hold no better candidate, and
+				 * those are discarded without going through the loop below. */
+				tmin = mins(dots, ynorm, xn, ny, bestd);
+				if (tmin >= bestd)
+					continue;
+				for (b = 0; b < ny; b++)
+				{
+					d = dots[b];
+					if (d < bestd)
+					{
+						/* Near-zero distances are dominated by cancellation, so
+						 * they're recomputed (this also spots equal vectors) */
+						if (d <= CANCEL_TOL*(xn + ynorm[b]))
+						{
+							xrow = frontview_row(X, x0 + a);
+							yrow = frontview_row(Y, y0 + b);
+							d = strided_squared_dist(xrow, xs, yrow, ys, vlen, scale);
+							if ((flags & BLOCKDIST_DISTINCT) && d == 0 &&
+									strided_vectors_are_equal(xrow, xs, yrow, ys, vlen))
+								continue;
+							if (d >= bestd)
+								continue;
+						}
+						bestd = d;
+						best = b;
+					}
+				}
+				if (best >= 0)
+				{
+					mindists[x0 + a] = bestd;
+					bestidx[a] = y0 + best;
+				}
+			}
+		}
+
+		for (a = 0; a < nx; a++)
+		{
+			if (bestidx[a] >= 0)
+			{
+				if (flags & BLOCKDIST_EXACT)
+					mindists[x0 + a] = strided_squared_dist(frontview_row(X, x0 + a), xs,
+							frontview_row(Y, bestidx[a]), ys, vlen, scale);
+				else if (mindists[x0 + a] < 0)
+					mindists[x0 + a] = 0;
+			}
+			if (nearest)
+				nearest[x0 + a] = bestidx[a];
+		}
+	}
+
+	free(Xp);
+	free(Yp);
+	free(xnorm);
+	free(ynorm);
+	free(acc);
+	free_vector(bestidx);
+}
@@ -0,0 +1,84 @@
+/*
+ * cpudispatch.c
+ *
+ * Run-time selection of kernel variants. The processor's features are queried through
+ * CPUID (which also checks the operating system saves the wider registers), and the
+ * choice is made once, the first time a kernel asks for it. Kernels are picked through
+ * plain function pointers rather than ifunc resolvers, since resolvers run before the
+ * environment can be safely read.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "cpudispatch.h"
+
+static pthread_once_t isa_once = PTHREAD_ONCE_INIT;
+static moo_isa_t active_isa = moo_isa_generic;
+
+moo_isa_t moo_cpu_isa(void)
+{
+#if MOO_ISA_VARIANTS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return moo_isa_avx512;
+	if (__builtin_cpu_supports("avx2"))
+		return moo_isa_avx2;
+#endif
+	return moo_isa_generic;
+}
+
+static void select_isa(void)
+{
+	moo_isa_t cpu = moo_cpu_isa();
+	const char *forced = getenv(MOO_ISA_ENV);
+
+	active_isa = cpu;
+	if (!forced)
+		return;
+	if (!strcmp(forced, "generic") || !strcmp(forced, "sse2"))
+		active_isa = moo_isa_generic;
+	else if (!strcmp(forced, "avx2") && cpu >= moo_isa_avx2)
+		active_isa = moo_isa_avx2;
+	else if (!strcmp(forced, "avx512") && cpu >= moo_isa_avx512)
+		active_isa = moo_isa_avx512;
+}
+
+moo_isa_t moo_active_isa(void)
+{
+	pthread_once(&isa_once, &select_isa);
+	return active_isa;
+}
+
+const char *moo_isa_name(moo_isa_t isa)
+{
+	switch (isa)
+	{
+		case moo_isa_avx2:
+			return "avx2";
+		case moo_isa_avx512:
+			return "avx512";
+		default:
+			return "generic";
+	}
+}
@@ -0,0 +1,237 @@
+/*
+ * crowding.c
+ *
+ * Crowding distance. Objective values are mapped to unsigned integers that sort in the
+ * same order as the values (the sign bit is flipped for non-negative values, and every
+ * bit for negative ones), and sorted along with the vectors' positions by a least
+ * significant digit radix sort. All the histograms are built in a single pass over the
+ * keys, and passes over digits every key shares are skipped, which is common for the
+ * exponent bits of values within a narrow range.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "crowding.h"
+
+// Radix sort digits: 6 passes of 11 bits cover the 64 bits of a key
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES 6
+
+// Fronts shorter than this are sorted by insertion
+#define RADIX_MIN_LEN 64
+
+#define SIGN_BIT (UINT64_C(1) << 63)
+
+static inline uint64_t double_to_key(double v)
+{
+	uint64_t u;
+
+	// Both zeros get the same key, as they compare equal
+	if (v == 0)
+		v = 0;
+	memcpy(&u, &v, sizeof(u));
+	return (u & SIGN_BIT) ? ~u : (u | SIGN_BIT);
+}
+
+static inline double key_to_double(uint64_t u)
+{
+	double v;
+
+	u = (u & SIGN_BIT) ? (u & ~SIGN_BIT) : ~u;
+	memcpy(&v, &u, sizeof(v));
+	return v;
+}
+
+crowding_workspace_t *new_crowding_workspace(void)
+{
+	crowding_workspace_t *W = checked_malloc(sizeof(crowding_workspace_t));
+
+	W->capacity = 0;
+	W->keys = W->keys2 = NULL;
+	W->order = W->order2 = NULL;
+	W->counts = NULL;
+	return W;
+}
+
+void free_crowding_workspace(crowding_workspace_t *W)
+{
+	if (!W)
+		return;
+	free(W->keys);
+	free(W->keys2);
+	free(W->order);
+	free(W->order2);
+	free(W->counts);
+	free(W);
+}
+
+static void reserve(crowding_workspace_t *W, int len)
+{
+	if (len <= W->capacity)
+		return;
+	free(W->keys);
+	free(W->keys2);
+	free(W->order);
+	free(W->order2);
+	W->keys = checked_malloc(sizeof(uint64_t)*len);
+	W->keys2 = checked_malloc(sizeof(uint64_t)*len);
+	W->order = checked_malloc(sizeof(int)*len);
+	W->order2 = checked_malloc(sizeof(int)*len);
+	W->capacity = len;
+	if (!W->counts)
+		W->counts = checked_malloc(sizeof(int)*RADIX_PASSES*RADIX_BUCKETS);
+}
+
+/* Sorts W->keys[0..len-1], and W->order along with them. Both stay in W->keys and
+ * W->order, whose buffers may be swapped with the second ones. */
+static void sort_keys(crowding_workspace_t *W, int len)
+{
+	int i, j, p, shift, o, pos, sum, c;
+	uint64_t k, *keys = W->keys, *kdst = W->keys2, *ktmp;
+	int *order = W->order, *odst = W->order2, *otmp, *counts;
+
+	if (len < RADIX_MIN_LEN)
+	{
+		for (i = 1; i < len; i++)
+		{
+			k = keys[i];
+			o = order[i];
+			for (j = i; j > 0 && keys[j-1] > k; j--)
+			{
+				keys[j] = keys[j-1];
+				order[j] = order[j-1];
+			}
+			keys[j] = k;
+			order[j] = o;
+		}
+		return;
+	}
+
+	counts = W->counts;
+	memset(counts, 0, sizeof(int)*RADIX_PASSES*RADIX_BUCKETS);
+	for (i = 0; i < len; i++)
+	{
+		k = keys[i];
+		for (p = 0; p < RADIX_PASSES; p++)
+			counts[p*RADIX_BUCKETS + ((k >> (p*RADIX_BITS)) & (RADIX_BUCKETS - 1))]++;
+	}
+
+	for (p = 0; p < RADIX_PASSES; p++)
+	{
+		shift = p*RADIX_BITS;
+		c = p*RADIX_BUCKETS;
+		if (counts[c + ((keys[0] >> shift) & (RADIX_BUCKETS - 1))] == len)
+			continue;
+		// Bucket counts to starting positions
+		sum = 0;
+		for (i = 0; i < RADIX_BUCKETS; i++)
+		{
+			pos = counts[c + i];
+			counts[c + i] = sum;
+			sum += pos;
+		}
+		for (i = 0; i < len; i++)
+		{
+			pos = counts[c + ((keys[i] >> shift) & (RADIX_BUCKETS - 1))]++;
+			kdst[pos] = keys[i];
+			odst[pos] = order[i];
+		}
+		ktmp = keys;
+		keys = kdst;
+		kdst = ktmp;
+		otmp = order;
+		order = odst;
+		odst = otmp;
+	}
+
+	W->keys = keys;
+	W->keys2 = kdst;
+	W->order = order;
+	W->order2 = odst;
+}
+
+void crowding_distance_view(const frontview_t *front, crowding_workspace_t *W,
+		double *dists)
+{
+	int i, k, lo, hi, len = front->len;
+	uint64_t *keys;
+	int *order;
+	double range, prev, next;
+	crowding_workspace_t *own = NULL;
+
+	if (len < 3)
+	{
+		for (i = 0; i < len; i++)
+			dists[i] = INFINITY;
+		return;
+	}
+	if (!W)
+		W = own = new_crowding_workspace();
+	reserve(W, len);
+
+	for (i = 0; i < len; i++)
+		dists[i] = 0;
+
+	for (k = 0; k < front->vlen; k++)
+	{
+		for (i = 0; i < len; i++)
+		{
+			W->keys[i] = double_to_key(frontview_at(front, i, k));
+			W->order[i] = i;
+		}
+		sort_keys(W, len);
+		keys = W->keys;
+		order = W->order;
+		if (keys[0] == keys[len-1])
+			continue;
+
+		// Every vector holding the minimum or the maximum value is a boundary one
+		for (lo = 0; lo < len && keys[lo] == keys[0]; lo++)
+			dists[order[lo]] = INFINITY;
+		for (hi = len - 1; hi >= 0 && keys[hi] == keys[len-1]; hi--)
+			dists[order[hi]] = INFINITY;
+
+		range = key_to_double(keys[len-1]) - key_to_double(keys[0]);
+		prev = key_to_double(keys[lo-1]);
+		for (i = lo; i <= hi; i++)
+		{
+			next = key_to_double(keys[i+1]);
+			dists[order[i]] += (next - prev) / range;
+			prev = key_to_double(keys[i]);
+		}
+	}
+
+	free_crowding_workspace(own);
+}
+
+void crowding_distance(double **front, int frontlen, int vlen, double *dists)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	crowding_distance_view(&view, NULL, dists);
+}
@@ -0,0 +1,174 @@
+/*
+ * crowdingcheck.c
+ *
+ * Checks crowding_distance_view against a straightforward implementation, which sorts
+ * every objective with qsort, on random fronts of several sizes: with many ties, with
+ * both signed zeros, with negative values and with objectives of null range. Exits
+ * with a failure status if any distance differs.
+ *
+ * Usage: crowdingcheck [-r rounds] [-s seed]
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "crowding.h"
+
+// Kinds of random data
+#define DATA_UNIFORM 0  /* distinct values in [-1, 1] */
+#define DATA_TIES    1  /* a few values, so most of them are tied */
+#define DATA_ZEROS   2  /* -0, 0, and a few other values */
+#define DATA_FLAT    3  /* like DATA_TIES, with some objectives of null range */
+#define DATA_KINDS   4
+
+static const char *kind_names[DATA_KINDS] = {"uniform", "ties", "signed zeros", "flat"};
+
+static const int lengths[] = {1, 2, 3, 4, 10, 63, 64, 65, 200, 1000, 5000};
+
+static const double *sort_values;
+
+// Sorts positions by value, ties by position (both zeros compare equal)
+static int cmp_positions(const void *a, const void *b)
+{
+	int i = *(const int*)a, j = *(const int*)b;
+
+	if (sort_values[i] < sort_values[j])
+		return -1;
+	if (sort_values[i] > sort_values[j])
+		return 1;
+	return (i > j) - (i < j);
+}
+
+/* Crowding distance as defined in crowding.h, with an objective sorted at a time */
+static void reference_crowding(const frontview_t *front, double *dists)
+{
+	int i, k, lo, hi, len = front->len;
+	int *order = new_vector_int(len + 1);
+	double *values = new_vector_double(len + 1);
+	double min, max, range;
+
+	for (i = 0; i < len; i++)
+		dists[i] = (len < 3) ? INFINITY : 0;
+	for (k = 0; k < front->vlen && len >= 3; k++)
+	{
+		for (i = 0; i < len; i++)
+		{
+			values[i] = frontview_at(front, i, k);
+			order[i] = i;
+		}
+		sort_values = values;
+		qsort(order, len, sizeof(int), &cmp_positions);
+		min = values[order[0]];
+		max = values[order[len-1]];
+		if (min == max)
+			continue;
+		range = max - min;
+
+		for (lo = 0; lo < len && values[order[lo]] == min; lo++)
+			dists[order[lo]] = INFINITY;
+		for (hi = len - 1; hi >= 0 && values[order[hi]] == max; hi--)
+			dists[order[hi]] = INFINITY;
+		for (i = lo; i <= hi; i++)
+			dists[order[i]] += (values[order[i+1]] - values[order[i-1]]) / range;
+	}
+	free_vector(order);
+	free_vector(values);
+}
+
+static double random_value(int kind, int k)
+{
+	static const double zeros[] = {-0.0, 0.0, -0.0, 0.0, 1.0, -1.0, 0.5};
+	double u = rand() / (RAND_MAX + 1.0);
+
+	switch (kind)
+	{
+		case DATA_UNIFORM:
+			return 2*u - 1;
+		case DATA_TIES:
+			return floor(u*8) - 3;
+		case DATA_ZEROS:
+			return zeros[(int)(u*7)];
+		default:
+			return (k % 2) ? 2.5 : floor(u*4);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int opt, r, rounds, seed, kind, l, len, vlen, i, k, failures, checks;
+	double *data, *dists, *expected;
+	frontview_t view;
+	crowding_workspace_t *W;
+
+	rounds = 20;
+	seed = 1;
+	while ((opt = getopt(argc, argv, "r:s:")) != -1)
+	{
+		if (opt == 'r')
+		{
+			rounds = atoi(optarg);
+		}
+		else if (opt == 's')
+		{
+			seed = atoi(optarg);
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-r rounds] [-s seed]\n", argv[0]);
+			return (EXIT_FAILURE);
+		}
+	}
+	srand(seed);
+
+	// The same workspace is reused across fronts of every size, as a caller would
+	W = new_crowding_workspace();
+	failures = checks = 0;
+	for (r = 0; r < rounds; r++)
+	{
+		for (kind = 0; kind < DATA_KINDS; kind++)
+		{
+			for (l = 0; l < (int)(sizeof(lengths)/sizeof(lengths[0])); l++)
+			{
+				len = lengths[l];
+				vlen = 1 + rand() % 5;
+				data = new_vector_double((size_t)len*vlen);
+				dists = new_vector_double(len);
+				expected = new_vector_double(len);
+				for (i = 0; i < len; i++)
+					for (k = 0; k < vlen; k++)
+						data[(size_t)i*vlen + k] = random_value(kind, k);
+				view = frontview_rowmajor(data, len, vlen);
+
+				reference_crowding(&view, expected);
+				crowding_distance_view(&view, (r % 2) ? NULL : W, dists);
+				for (i = 0; i < len; i++)
+				{
+					if (dists[i] != expected[i])
+					{
+						fprintf(stderr, "Mismatch (%s data, %d vectors, %d objectives): "
+								"vector %d got %.17g, expected %.17g\n", kind_names[kind],
+								len, vlen, i, dists[i], expected[i]);
+						failures++;
+						break;
+					}
+				}
+				checks++;
+
+				free_vector(data);
+				free_vector(dists);
+				free_vector(expected);
+			}
+		}
+	}
+	free_crowding_workspace(W);
+
+	printf("Crowding distance: %d fronts checked, %d mismatches\n", checks, failures);
+	return failures ? (EXIT_FAILURE) : (EXIT_SUCCESS);
+}
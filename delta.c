@@ -31,43 +31,74 @@
 #include <stdlib.h>
 #include <float.h>
 #include <math.h>
+#include <string.h>
 
 #include "memalloc.h"
+#include "frontview.h"
 #include "moutils.h"
 #include "delta.h"
+#include "biobj.h"
+#include "nearest.h"
+#include "reffront.h"
 
-double spread(double **front, int frontlen,
-		double **truefront, int truefrontlen)
+/* Normalized distance between the i-th vector of A and the j-th vector of B */
+static inline double view_dist(const frontview_t *A, int i, const frontview_t *B, int j,
+		int vlen, const double *scale)
+{
+	return sqrt(strided_squared_dist(frontview_row(A, i), A->cstride,
+			frontview_row(B, j), B->cstride, vlen, scale));
+}
+
+/* Index of the lexicographically smallest (or largest, if sign is -1) vector of a set */
+static int lexicographical_extreme(const frontview_t *set, int sign)
+{
+	int i, best;
+	double x, y, bx, by;
+
+	best = 0;
+	for (i = 1; i < set->len; i++)
+	{
+		x = frontview_at(set, i, 0) * sign;
+		y = frontview_at(set, i, 1) * sign;
+		bx = frontview_at(set, best, 0) * sign;
+		by = frontview_at(set, best, 1) * sign;
+		if (x < bx || (x == bx && y < by))
+			best = i;
+	}
+	return best;
+}
+
+/* Body of scaled_spread_view, given the positions of the lexicographically smallest and
+ * largest vectors of the true front */
+static double spread_body(const frontview_t *front, const frontview_t *truefront,
+		int tf_first, int tf_last, const double *scale)
 {
 	size_t i;
 	int vlen = 2;
+	int frontlen = front->len;
 	double df, dl, dbar, diversity, res;
-	double *min_values, *max_values;
-	double **norm_front, **norm_truefront;
-
-	// Normalize fronts
-	min_values = get_min_values(truefront, truefrontlen, vlen);
-	max_values = get_max_values(truefront, truefrontlen, vlen);
+	double *gaps;
+	staircase_t *S;
 
-	norm_front = normalize_front(front, frontlen, vlen,
-			min_values, max_values);
-	norm_truefront = normalize_front(truefront, truefrontlen, vlen,
-			min_values, max_values);
+	/* Normalization is applied lazily through the true front's scale factors. Since it
+	 * doesn't change the ordering of the vectors, the front is sorted as it is, into a
+	 * separate buffer, so the caller's data is left untouched. Only the extremes of the
+	 * true front are needed, so it's not sorted at all. */
+	S = staircase_build(front, scale);
 
-	// Lexicographically sort fronts
-	qsort(norm_front, frontlen, sizeof(norm_front[0]), &lexicographical_compare);
-	qsort(norm_truefront, truefrontlen, sizeof(norm_truefront[0]), &lexicographical_compare);
 	// Obtain the extreme distances
-	df = eucdist(norm_front[0], norm_truefront[0], vlen);
-	dl = eucdist(norm_front[frontlen-1], norm_truefront[truefrontlen-1], vlen);
+	df = view_dist(front, S->index[0], truefront, tf_first, vlen, scale);
+	dl = view_dist(front, S->index[frontlen-1], truefront, tf_last, vlen, scale);
 
 	/* Perform calculations.
 	 * First, the mean distance of all the euclidian distances between consecutive vectors
-	 * in the reference set is calculated. */
+	 * in the reference set is calculated. Each of those distances is computed only once. */
+	gaps = new_vector_double(frontlen);
 	dbar = 0;
 	for (i = 0; i < (frontlen-1); i++)
 	{
-		dbar += eucdist(norm_front[i], norm_front[i+1], vlen);
+		gaps[i] = view_dist(front, S->index[i], front, S->index[i+1], vlen, scale);
+		dbar += gaps[i];
 	}
 	dbar = dbar / (frontlen-1);
 
@@ -78,7 +109,7 @@ double spread(double **front, int frontlen,
 		diversity = df + dl;
 		for (i = 0; i < (frontlen-1); i++)
 		{
-			diversity += fabs(eucdist(norm_front[i], norm_front[i+1], vlen) - dbar);
+			diversity += fabs(gaps[i] - dbar);
 		}
 		/* The denominator of the final division represents the ideal distribution
 		 * of all distances. */
@@ -90,112 +121,205 @@ double spread(double **front, int frontlen,
 	}
 
 	// Free used arrays
-	free_matrix((void**)norm_front, frontlen);
-	free_matrix((void**)norm_truefront, truefrontlen);
-	free_vector(min_values);
-	free_vector(max_values);
+	free_vector(gaps);
+	free_staircase(S);
 
 	return (res);
 }
 
-double generalized_spread(double **front, int frontlen, double **truefront, int truefrontlen, int nobj)
+double scaled_spread_view(const frontview_t *front, const frontview_t *truefront,
+		const double *scale)
+{
+	return spread_body(front, truefront, lexicographical_extreme(truefront, 1),
+			lexicographical_extreme(truefront, -1), scale);
+}
+
+/* Body of scaled_generalized_spread_view, given the extreme solutions of the true front */
+static double generalized_spread_body(const frontview_t *front,
+		const frontview_t *truefront, const int *extreme_sols, const double *scale)
 {
 	size_t i;
+	int nobj = front->vlen, frontlen = front->len;
 	double sum, sum_extremis, dbar, res;
-	double *min_values, *max_values;
-	double **extreme_sols, **norm_front, **norm_truefront;
-
-	min_values = get_min_values(truefront, truefrontlen, nobj);
-	max_values = get_max_values(truefront, truefrontlen, nobj);
-
-	norm_front = normalize_front(front, frontlen, nobj,
-			min_values, max_values);
-	norm_truefront = normalize_front(truefront, truefrontlen, nobj,
-			min_values, max_values);
+	double *nndist;
 
-	extreme_sols = get_extreme_sols(norm_truefront, truefrontlen, nobj);
+	// Nearest neighbour distances within the front, shared by both sums below
+	nndist = new_vector_double(frontlen);
+	all_nearest_neighbours_view(front, scale, nndist, NULL);
 
 	dbar = 0;
 	for (i = 0; i < frontlen; i++)
 	{
-		dbar += sqrt(dist_nearest_point(norm_front[i], nobj, norm_front, frontlen));
+		dbar += sqrt(nndist[i]);
 	}
 	dbar = dbar / frontlen;
 
 	sum_extremis = 0;
 	for (i = 0; i < nobj; i++)
 	{
-		sum_extremis += sqrt(dist_closed_point(extreme_sols[i],
-				nobj, norm_front, frontlen));
+		sum_extremis += sqrt(view_dist_closed_point(frontview_row(truefront, extreme_sols[i]),
+				truefront->cstride, front, scale));
 	}
 
 	sum = 0;
 //	for (i = 0; i < truefrontlen; i ++)
 	for (i = 0; i < frontlen; i ++)
 	{
-		sum += fabs(sqrt(dist_nearest_point(norm_front[i], nobj,
-				norm_front, frontlen)) - dbar);
+		sum += fabs(sqrt(nndist[i]) - dbar);
 //		sum += sqrt(dist_nearest_point(norm_front[i], nobj,
 //						norm_front, frontlen)) - dbar;
 	}
 
 	res = (sum + sum_extremis)/(sum_extremis + frontlen*dbar);
 
-	free_matrix((void**)norm_front, frontlen);
-	free_matrix((void**)norm_truefront, truefrontlen);
-	free_matrix((void**)extreme_sols, nobj);
-	free_vector(min_values);
-	free_vector(max_values);
+	free_vector(nndist);
 	return (res);
 }
 
-double generalized_spread_original(double **front, int frontlen, double **truefront, int truefrontlen, int nobj)
+double scaled_generalized_spread_view(const frontview_t *front, const frontview_t *truefront,
+		const double *scale)
 {
-	size_t i;
-	double sum, sum_extremis, dbar, res;
-	double *min_values, *max_values;
-	double **extreme_sols, **norm_front, **norm_truefront;
+	double res;
+	int extreme_sols[front->vlen];
 
-	min_values = get_min_values(truefront, truefrontlen, nobj);
-	max_values = get_max_values(truefront, truefrontlen, nobj);
+	/* Normalizing is monotonic, so the extreme solutions of the normalized true front
+	 * are the same vectors as in the original one. */
+	view_extreme_sols(truefront, extreme_sols);
+	res = generalized_spread_body(front, truefront, extreme_sols, scale);
+	return (res);
+}
 
-	norm_front = normalize_front(front, frontlen, nobj,
-			min_values, max_values);
-	norm_truefront = normalize_front(truefront, truefrontlen, nobj,
-			min_values, max_values);
+/* Body of scaled_generalized_spread_original_view, given the extreme solutions of the
+ * true front. If the true front is a prepared one, R is it, and the distances are put
+ * back into the order of the original front before accumulating them. */
+static double generalized_spread_original_body(const frontview_t *front,
+		const frontview_t *truefront, const int *extreme_sols, const double *scale,
+		const reffront_t *R)
+{
+	size_t i;
+	int nobj = front->vlen, truefrontlen = truefront->len;
+	double sum, sum_extremis, dbar, res;
+	double *nndist, *dists;
 
-	extreme_sols = get_extreme_sols(norm_truefront, truefrontlen, nobj);
+	nndist = new_vector_double(truefrontlen);
+	nearest_squared_dists(truefront, front, scale, NEAREST_DISTINCT, nndist, NULL);
+	if (R)
+	{
+		dists = nndist;
+		nndist = new_vector_double(truefrontlen);
+		reffront_original_order(R, dists, nndist);
+		free_vector(dists);
+	}
 
 	dbar = 0;
 	for (i = 0; i < truefrontlen; i++)
 	{
-		dbar += dist_nearest_point(norm_truefront[i], nobj, norm_front, frontlen);
+		dbar += nndist[i];
 	}
 	dbar = dbar / truefrontlen;
 
 	sum_extremis = 0;
 	for (i = 0; i < nobj; i++)
 	{
-		sum_extremis += dist_nearest_point(extreme_sols[i],
-				nobj, norm_front, frontlen);
+		sum_extremis += view_dist_nearest_point(frontview_row(truefront, extreme_sols[i]),
+				truefront->cstride, front, scale);
 	}
 
 	sum = 0;
 	for (i = 0; i < truefrontlen; i ++)
 //	for (i = 0; i < frontlen; i ++)
 	{
-		sum += fabs(dist_nearest_point(norm_truefront[i], nobj,
-				norm_front, frontlen) - dbar);
+		sum += fabs(nndist[i] - dbar);
 //		sum += sqrt(dist_nearest_point(norm_front[i], nobj,
 //						norm_front, frontlen)) - dbar;
 	}
 
 	res = (sum + sum_extremis)/(sum_extremis + truefrontlen*dbar);
 
-	free_matrix((void**)norm_front, frontlen);
-	free_matrix((void**)norm_truefront, truefrontlen);
-	free_matrix((void**)extreme_sols, nobj);
-	free_vector(min_values);
-	free_vector(max_values);
+	free_vector(nndist);
+	return (res);
+}
+
+double scaled_generalized_spread_original_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale)
+{
+	double res;
+	int extreme_sols[front->vlen];
+
+	// See scaled_generalized_spread_view
+	view_extreme_sols(truefront, extreme_sols);
+	res = generalized_spread_original_body(front, truefront, extreme_sols, scale, NULL);
+	return (res);
+}
+
+double spread_view(const frontview_t *front, const frontview_t *truefront)
+{
+	double res, *scale;
+
+	// Normalization is applied lazily, through the true front's scale factors
+	scale = view_norm_scale(truefront);
+	res = scaled_spread_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double generalized_spread_view(const frontview_t *front, const frontview_t *truefront)
+{
+	double res, *scale;
+
+	scale = view_norm_scale(truefront);
+	res = scaled_generalized_spread_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double generalized_spread_original_view(const frontview_t *front, const frontview_t *truefront)
+{
+	double res, *scale;
+
+	scale = view_norm_scale(truefront);
+	res = scaled_generalized_spread_original_view(front, truefront, scale);
+	free_vector(scale);
 	return (res);
 }
+
+double spread(double **front, int frontlen,
+		double **truefront, int truefrontlen)
+{
+	frontview_t f = frontview_matrix(front, frontlen, 2);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, 2);
+	return spread_view(&f, &t);
+}
+
+double generalized_spread(double **front, int frontlen, double **truefront, int truefrontlen, int nobj)
+{
+	frontview_t f = frontview_matrix(front, frontlen, nobj);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, nobj);
+	return generalized_spread_view(&f, &t);
+}
+
+double generalized_spread_original(double **front, int frontlen, double **truefront, int truefrontlen, int nobj)
+{
+	frontview_t f = frontview_matrix(front, frontlen, nobj);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, nobj);
+	return generalized_spread_original_view(&f, &t);
+}
+
+double spread_ref(const frontview_t *front, const reffront_t *truefront)
+{
+	return spread_body(front, &truefront->view, truefront->order[0],
+			truefront->order[truefront->len-1], truefront->scale);
+}
+
+double generalized_spread_ref(const frontview_t *front, const reffront_t *truefront)
+{
+	return generalized_spread_body(front, &truefront->view, truefront->extremes,
+			truefront->scale);
+}
+
+double generalized_spread_original_ref(const frontview_t *front,
+		const reffront_t *truefront)
+{
+	return generalized_spread_original_body(front, &truefront->view, truefront->extremes,
+			truefront->scale, truefront);
+}
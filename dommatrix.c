@@ -0,0 +1,241 @@
+/*
+ * dommatrix.c
+ *
+ * Bit-parallel dominance matrix. For every objective k the vectors are sorted once,
+ * and sweeping them from the worst value to the best one builds, for each vector i,
+ * the set of vectors whose k-th component is greater or equal than the one of i.
+ * The intersection of those sets over all the objectives (computed one 64-bit word at
+ * a time) is the set of vectors weakly dominated by i, and removing the vectors equal
+ * to i from it yields the set of vectors dominated by i.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "dommatrix.h"
+
+typedef struct
+{
+	double value;
+	int cls;
+	int index;
+}sort_entry;
+
+static int entry_compare(const void *_a, const void *_b)
+{
+	const sort_entry *a = (const sort_entry*)_a;
+	const sort_entry *b = (const sort_entry*)_b;
+
+	if (a->value < b->value)
+		return -1;
+	if (a->value > b->value)
+		return 1;
+	if (a->cls < b->cls)
+		return -1;
+	if (a->cls > b->cls)
+		return 1;
+	return 0;
+}
+
+static inline int popcount64(uint64_t w)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(w);
+#else
+	int c;
+	for (c = 0; w; c++)
+		w &= w - 1;
+	return c;
+#endif
+}
+
+static inline int ctz64(uint64_t w)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(w);
+#else
+	int c = 0;
+	while (!(w & 1))
+	{
+		w >>= 1;
+		c++;
+	}
+	return c;
+#endif
+}
+
+dommatrix_t *dominance_matrix_view(const frontview_t *set)
+{
+	int setlen = set->len, vlen = set->vlen;
+	size_t i, w, words;
+	int k, g, p, q, c, nclasses;
+	uint64_t *row, *acc, word, lastmask;
+	sort_entry *entries;
+	int *cls, *cls_start, *members;
+	dommatrix_t *M;
+
+	M = checked_malloc(sizeof(dommatrix_t));
+	words = (setlen + 63) / 64;
+	M->n = setlen;
+	M->words = (int)words;
+	M->bits = checked_malloc(sizeof(uint64_t)*words*setlen);
+	M->dom_count = new_vector_int(setlen);
+	M->dominates_count = new_vector_int(setlen);
+	M->dominated_by_start = new_vector_int(setlen + 1);
+
+	lastmask = (setlen % 64) ? ((UINT64_C(1) << (setlen % 64)) - 1) : ~UINT64_C(0);
+	for (i = 0; i < (size_t)setlen; i++)
+	{
+		row = M->bits + i*words;
+		for (w = 0; w < words; w++)
+			row[w] = ~UINT64_C(0);
+		row[words-1] = lastmask;
+	}
+
+	acc = checked_malloc(sizeof(uint64_t)*(words ? words : 1));
+	entries = checked_malloc(sizeof(sort_entry)*setlen);
+	cls = new_vector_int(setlen);
+
+	/* Each objective is swept from its worst value to its best one. 'acc' holds the
+	 * vectors already visited, that is, the ones whose k-th component is greater or
+	 * equal than the current one. Ties are added as a whole before intersecting.
+	 * On the way, 'cls' is refined so that, at the end, two vectors share a class
+	 * only if they are equal in every component. */
+	for (k = 0; k < vlen; k++)
+	{
+		for (i = 0; i < (size_t)setlen; i++)
+		{
+			entries[i].value = frontview_at(set, (int)i, k);
+			entries[i].cls = cls[i];
+			entries[i].index = (int)i;
+		}
+		qsort(entries, setlen, sizeof(sort_entry), &entry_compare);
+
+		for (w = 0; w < words; w++)
+			acc[w] = 0;
+		nclasses = 0;
+		p = setlen - 1;
+		while (p >= 0)
+		{
+			g = p;
+			while (g > 0 && entries[g-1].value == entries[p].value)
+				g--;
+			for (q = g; q <= p; q++)
+				acc[entries[q].index >> 6] |= UINT64_C(1) << (entries[q].index & 63);
+			for (q = g; q <= p; q++)
+			{
+				if (q == g || entries[q].cls != entries[q-1].cls)
+					nclasses++;
+				cls[entries[q].index] = nclasses - 1;
+				row = M->bits + (size_t)entries[q].index*words;
+				for (w = 0; w < words; w++)
+					row[w] &= acc[w];
+			}
+			p = g - 1;
+		}
+	}
+
+	/* Equal vectors weakly dominate each other (and every vector weakly dominates
+	 * itself), so those bits are cleared class by class. */
+	cls_start = new_vector_int(setlen + 1);
+	members = checked_malloc(sizeof(int)*setlen);
+	for (i = 0; i < (size_t)setlen; i++)
+		cls_start[cls[i] + 1]++;
+	for (c = 0; c < setlen; c++)
+		cls_start[c + 1] += cls_start[c];
+	for (i = 0; i < (size_t)setlen; i++)
+		members[cls_start[cls[i]]++] = (int)i;
+	for (c = setlen; c > 0; c--)
+		cls_start[c] = cls_start[c - 1];
+	cls_start[0] = 0;
+	for (c = 0; c < setlen; c++)
+	{
+		for (p = cls_start[c]; p < cls_start[c + 1]; p++)
+		{
+			row = M->bits + (size_t)members[p]*words;
+			for (q = cls_start[c]; q < cls_start[c + 1]; q++)
+				row[members[q] >> 6] &= ~(UINT64_C(1) << (members[q] & 63));
+		}
+	}
+
+	// Derived counts and dominated-by lists
+	for (i = 0; i < (size_t)setlen; i++)
+	{
+		row = M->bits + i*words;
+		for (w = 0; w < words; w++)
+		{
+			word = row[w];
+			M->dominates_count[i] += popcount64(word);
+			while (word)
+			{
+				M->dom_count[w*64 + ctz64(word)]++;
+				word &= word - 1;
+			}
+		}
+	}
+	for (i = 0; i < (size_t)setlen; i++)
+		M->dominated_by_start[i + 1] = M->dominated_by_start[i] + M->dom_count[i];
+	M->dominated_by = checked_malloc(sizeof(int)*M->dominated_by_start[setlen]);
+	for (i = 0; i < (size_t)setlen; i++)
+		cls_start[i] = M->dominated_by_start[i];
+	for (i = 0; i < (size_t)setlen; i++)
+	{
+		row = M->bits + i*words;
+		for (w = 0; w < words; w++)
+		{
+			word = row[w];
+			while (word)
+			{
+				M->dominated_by[cls_start[w*64 + ctz64(word)]++] = (int)i;
+				word &= word - 1;
+			}
+		}
+	}
+
+	free(acc);
+	free(entries);
+	free(members);
+	free_vector(cls);
+	free_vector(cls_start);
+	return M;
+}
+
+dommatrix_t *dominance_matrix(double **set, int setlen, int vlen)
+{
+	frontview_t view = frontview_matrix(set, setlen, vlen);
+	return dominance_matrix_view(&view);
+}
+
+void free_dommatrix(dommatrix_t *M)
+{
+	if (!M)
+		return;
+	free(M->bits);
+	free_vector(M->dom_count);
+	free_vector(M->dominates_count);
+	free_vector(M->dominated_by_start);
+	free(M->dominated_by);
+	free(M);
+}
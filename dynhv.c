@@ -0,0 +1,428 @@
+/*
+ * dynhv.c
+ *
+ * Dynamic bi-objective hypervolume. In a staircase sorted by the first objective, with
+ * x' the first objective of the next vector (or of the reference point r, for the last
+ * one) and y' the second objective of the previous one (or r's, for the first one),
+ * a vector (x, y) owns the rectangle (x' - x)*(r_y - y) of the hypervolume, and its
+ * exclusive contribution is (x' - x)*(y' - y). Both only depend on the vector's
+ * neighbours, so every change to the staircase only touches those of the vectors next
+ * to it.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "memalloc.h"
+#include "dynhv.h"
+
+typedef struct hv_node
+{
+	double x, y;
+	double strip;              /* rectangle owned by the vector */
+	double sum;                /* rectangles of the subtree */
+	double contrib;            /* exclusive contribution */
+	int height;
+	int heappos;
+	struct hv_node *left, *right;
+}hv_node;
+
+struct dynhv
+{
+	double rx, ry;
+	hv_node *root;
+	int len;
+	hv_node **heap;            /* min-heap of exclusive contributions */
+	int heapcap;
+};
+
+static inline int cmp_key(double x1, double y1, double x2, double y2)
+{
+	if (x1 != x2)
+		return (x1 < x2) ? -1 : 1;
+	if (y1 != y2)
+		return (y1 < y2) ? -1 : 1;
+	return 0;
+}
+
+/* AVL tree */
+
+static inline int height(const hv_node *n)
+{
+	return n ? n->height : 0;
+}
+
+static inline double subtree_sum(const hv_node *n)
+{
+	return n ? n->sum : 0;
+}
+
+static inline void fix(hv_node *n)
+{
+	int hl = height(n->left), hr = height(n->right);
+	n->height = 1 + ((hl > hr) ? hl : hr);
+	n->sum = subtree_sum(n->left) + n->strip + subtree_sum(n->right);
+}
+
+static hv_node *rotate_right(hv_node *n)
+{
+	hv_node *l = n->left;
+	n->left = l->right;
+	l->right = n;
+	fix(n);
+	fix(l);
+	return l;
+}
+
+static hv_node *rotate_left(hv_node *n)
+{
+	hv_node *r = n->right;
+	n->right = r->left;
+	r->left = n;
+	fix(n);
+	fix(r);
+	return r;
+}
+
+static hv_node *balance(hv_node *n)
+{
+	fix(n);
+	if (height(n->left) > height(n->right) + 1)
+	{
+		if (height(n->left->right) > height(n->left->left))
+			n->left = rotate_left(n->left);
+		return rotate_right(n);
+	}
+	if (height(n->right) > height(n->left) + 1)
+	{
+		if (height(n->right->left) > height(n->right->right))
+			n->right = rotate_right(n->right);
+		return rotate_left(n);
+	}
+	return n;
+}
+
+static hv_node *tree_insert(hv_node *n, hv_node *v)
+{
+	if (!n)
+		return v;
+	if (cmp_key(v->x, v->y, n->x, n->y) < 0)
+		n->left = tree_insert(n->left, v);
+	else
+		n->right = tree_insert(n->right, v);
+	return balance(n);
+}
+
+// Unlinks the first node of a subtree
+static hv_node *tree_remove_min(hv_node *n, hv_node **min)
+{
+	if (!n->left)
+	{
+		*min = n;
+		return n->right;
+	}
+	n->left = tree_remove_min(n->left, min);
+	return balance(n);
+}
+
+// Unlinks a node, which must be in the subtree
+static hv_node *tree_remove(hv_node *n, const hv_node *v)
+{
+	int c = cmp_key(v->x, v->y, n->x, n->y);
+	hv_node *min, *right;
+
+	if (c < 0)
+		n->left = tree_remove(n->left, v);
+	else if (c > 0)
+		n->right = tree_remove(n->right, v);
+	else
+	{
+		if (!n->right)
+			return n->left;
+		right = tree_remove_min(n->right, &min);
+		min->left = n->left;
+		min->right = right;
+		n = min;
+	}
+	return balance(n);
+}
+
+// Recomputes the sums along the path to a node whose rectangle changed
+static void tree_refresh(hv_node *n, const hv_node *v)
+{
+	int c = cmp_key(v->x, v->y, n->x, n->y);
+
+	if (c < 0)
+		tree_refresh(n->left, v);
+	else if (c > 0)
+		tree_refresh(n->right, v);
+	fix(n);
+}
+
+static hv_node *find(const dynhv_t *H, double x, double y)
+{
+	int c;
+	hv_node *n = H->root;
+
+	while (n && (c = cmp_key(x, y, n->x, n->y)) != 0)
+		n = (c < 0) ? n->left : n->right;
+	return n;
+}
+
+// Last node before (x, y), or at it if inclusive
+static hv_node *pred(const dynhv_t *H, double x, double y, int inclusive)
+{
+	int c;
+	hv_node *n = H->root, *best = NULL;
+
+	while (n)
+	{
+		c = cmp_key(n->x, n->y, x, y);
+		if (c < 0 || (inclusive && c == 0))
+		{
+			best = n;
+			n = n->right;
+		}
+		else
+			n = n->left;
+	}
+	return best;
+}
+
+// First node after (x, y)
+static hv_node *succ(const dynhv_t *H, double x, double y)
+{
+	hv_node *n = H->root, *best = NULL;
+
+	while (n)
+	{
+		if (cmp_key(n->x, n->y, x, y) > 0)
+		{
+			best = n;
+			n = n->left;
+		}
+		else
+			n = n->right;
+	}
+	return best;
+}
+
+/* Heap of contributions */
+
+static void heap_swap(dynhv_t *H, int i, int j)
+{
+	hv_node *t = H->heap[i];
+	H->heap[i] = H->heap[j];
+	H->heap[j] = t;
+	H->heap[i]->heappos = i;
+	H->heap[j]->heappos = j;
+}
+
+static void heap_fix(dynhv_t *H, int i)
+{
+	int c;
+
+	while (i > 0 && H->heap[i]->contrib < H->heap[(i - 1) / 2]->contrib)
+	{
+		heap_swap(H, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+	for (;;)
+	{
+		c = 2*i + 1;
+		if (c >= H->len)
+			break;
+		if (c + 1 < H->len && H->heap[c+1]->contrib < H->heap[c]->contrib)
+			c++;
+		if (H->heap[c]->contrib >= H->heap[i]->contrib)
+			break;
+		heap_swap(H, i, c);
+		i = c;
+	}
+}
+
+static void heap_remove(dynhv_t *H, hv_node *v)
+{
+	int i = v->heappos;
+
+	H->len--;
+	if (i == H->len)
+		return;
+	H->heap[i] = H->heap[H->len];
+	H->heap[i]->heappos = i;
+	heap_fix(H, i);
+}
+
+/* Recomputes the rectangle and the contribution of a vector from its neighbours */
+static void update(dynhv_t *H, hv_node *v)
+{
+	hv_node *prev = pred(H, v->x, v->y, 0), *next = succ(H, v->x, v->y);
+	double width = (next ? next->x : H->rx) - v->x;
+
+	v->strip = width * (H->ry - v->y);
+	v->contrib = width * ((prev ? prev->y : H->ry) - v->y);
+	tree_refresh(H->root, v);
+	heap_fix(H, v->heappos);
+}
+
+static void unlink_node(dynhv_t *H, hv_node *v)
+{
+	H->root = tree_remove(H->root, v);
+	heap_remove(H, v);
+	free(v);
+}
+
+dynhv_t *new_dynhv(const double *ref)
+{
+	dynhv_t *H = checked_realloc(NULL, sizeof(dynhv_t));
+
+	H->rx = ref[0];
+	H->ry = ref[1];
+	H->root = NULL;
+	H->len = 0;
+	H->heapcap = 16;
+	H->heap = checked_realloc(NULL, sizeof(hv_node*)*H->heapcap);
+	return H;
+}
+
+void free_dynhv(dynhv_t *H)
+{
+	int i;
+
+	if (!H)
+		return;
+	for (i = 0; i < H->len; i++)
+		free(H->heap[i]);
+	free(H->heap);
+	free(H);
+}
+
+int dynhv_insert(dynhv_t *H, const double *v)
+{
+	int removed = 0;
+	double x = v[0], y = v[1];
+	hv_node *n, *p;
+
+	if (!(x < H->rx && y < H->ry))
+		return -1;
+	n = pred(H, x, y, 1);
+	if (n && n->y <= y)
+		return -1;
+
+	// The vectors it dominates come right after it, while their second objective isn't better
+	while ((n = succ(H, x, y)) && n->y >= y)
+	{
+		unlink_node(H, n);
+		removed++;
+	}
+
+	n = checked_realloc(NULL, sizeof(hv_node));
+	n->x = x;
+	n->y = y;
+	n->strip = n->sum = n->contrib = 0;
+	n->height = 1;
+	n->left = n->right = NULL;
+	H->root = tree_insert(H->root, n);
+	if (H->len == H->heapcap)
+	{
+		H->heapcap *= 2;
+		H->heap = checked_realloc(H->heap, sizeof(hv_node*)*H->heapcap);
+	}
+	n->heappos = H->len;
+	H->heap[H->len++] = n;
+
+	update(H, n);
+	if ((p = pred(H, x, y, 0)))
+		update(H, p);
+	if ((p = succ(H, x, y)))
+		update(H, p);
+	return removed;
+}
+
+int dynhv_remove(dynhv_t *H, const double *v)
+{
+	hv_node *n = find(H, v[0], v[1]), *prev, *next;
+
+	if (!n)
+		return 0;
+	prev = pred(H, v[0], v[1], 0);
+	next = succ(H, v[0], v[1]);
+	unlink_node(H, n);
+	if (prev)
+		update(H, prev);
+	if (next)
+		update(H, next);
+	return 1;
+}
+
+int dynhv_len(const dynhv_t *H)
+{
+	return H->len;
+}
+
+double dynhv_value(const dynhv_t *H)
+{
+	return subtree_sum(H->root);
+}
+
+double dynhv_gain(const dynhv_t *H, const double *v)
+{
+	double x = v[0], y = v[1], cx, cy, gain = 0;
+	hv_node *n;
+
+	if (!(x < H->rx && y < H->ry))
+		return 0;
+	n = pred(H, x, y, 1);
+	if (n && n->y <= y)
+		return 0;
+
+	/* Walks the staircase from the vector on, adding the area between the vector and
+	 * each step above it */
+	cx = x;
+	cy = n ? n->y : H->ry;
+	for (n = succ(H, x, y); n && n->y >= y; n = succ(H, n->x, n->y))
+	{
+		gain += (n->x - cx) * (cy - y);
+		cx = n->x;
+		cy = n->y;
+	}
+	gain += ((n ? n->x : H->rx) - cx) * (cy - y);
+	return gain;
+}
+
+double dynhv_contribution(const dynhv_t *H, const double *v)
+{
+	hv_node *n = find(H, v[0], v[1]);
+	return n ? n->contrib : -1;
+}
+
+double dynhv_min_contributor(const dynhv_t *H, double *v)
+{
+	if (H->len == 0)
+		return -1;
+	if (v)
+	{
+		v[0] = H->heap[0]->x;
+		v[1] = H->heap[0]->y;
+	}
+	return H->heap[0]->contrib;
+}
@@ -0,0 +1,752 @@
+/*
+ * eaf.c
+ *
+ * Empirical attainment function. With two objectives, a point (x, y) is attained by
+ * as many runs as have reached some y' <= y among their points with x' <= x, so a
+ * single sweep along the first objective, keeping the best y of every run in sorted
+ * order, gives every surface at once: the k-th smallest of those values only changes
+ * where the k-th surface has a point. Three objectives are handled by sweeping along
+ * the third one, keeping the two-objective staircase of every run and of every level in
+ * balanced trees: every new point only changes the staircases locally, and the points
+ * it adds to them are the points of the three-objective surfaces.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <errno.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "eaf.h"
+
+/* Point of a run, projected on the first two objectives, with the third one */
+typedef struct
+{
+	double x, y, z;
+	int run;
+}eaf_point;
+
+/* Points of a surface, growing as they're found */
+typedef struct
+{
+	double *pts;
+	int len;
+	int cap;
+	int vlen;
+}eaf_buffer;
+
+/* State of the two-objective sweep: the best y reached by every run, the same values
+ * in ascending order, and the last value of every surface */
+typedef struct
+{
+	int nruns;
+	int nlevels;
+	const int *levels;
+	double *best;
+	double *sorted;
+	double *last;
+}eaf_sweep;
+
+// Staircase nodes are allocated this many at a time
+#define EAF_CHUNK 4096
+
+/* Point of a two-objective staircase, in an AVL tree ordered by x (and so by
+ * descending y, as none of the points dominates another), and in a list in that
+ * order */
+typedef struct eaf_node
+{
+	double x, y;
+	int height;
+	struct eaf_node *left, *right;
+	struct eaf_node *prev, *next;
+}eaf_node;
+
+/* Staircase nodes, recycled through a free list linked by their left pointers */
+typedef struct
+{
+	eaf_node *free;
+	eaf_node **chunks;
+	int nchunks;
+}eaf_pool;
+
+/* State of the three-objective sweep: the staircase of the projections seen so far of
+ * every run, and the staircase of every level (the minimal points attained by at least
+ * that many runs), up to the highest level wanted; levels[0] stands for the whole
+ * plane. Points found in the staircases of the wanted levels are kept until the points
+ * with the same third objective are all in. */
+typedef struct
+{
+	int maxlevel;
+	eaf_node **runs;
+	eaf_node **levels;
+	int *wanted;
+	eaf_buffer *found;
+	eaf_pool pool;
+	eaf_node **near;           /* points of a run's staircase next to a new point */
+	int nnear;
+	int nearcap;
+}eaf_state;
+
+static void buffer_push(eaf_buffer *B, double x, double y, double z)
+{
+	if (B->len == B->cap)
+	{
+		B->cap = B->cap ? 2*B->cap : 16;
+		B->pts = checked_realloc(B->pts, sizeof(double)*B->cap*B->vlen);
+	}
+	B->pts[(size_t)B->len*B->vlen] = x;
+	B->pts[(size_t)B->len*B->vlen + 1] = y;
+	if (B->vlen > 2)
+		B->pts[(size_t)B->len*B->vlen + 2] = z;
+	B->len++;
+}
+
+static int cmp_xy(const void *a, const void *b)
+{
+	const eaf_point *p = (const eaf_point*)a, *q = (const eaf_point*)b;
+	if (p->x != q->x)
+		return (p->x < q->x) ? -1 : 1;
+	if (p->y != q->y)
+		return (p->y < q->y) ? -1 : 1;
+	return 0;
+}
+
+static int cmp_z(const void *a, const void *b)
+{
+	const eaf_point *p = (const eaf_point*)a, *q = (const eaf_point*)b;
+	if (p->z != q->z)
+		return (p->z < q->z) ? -1 : 1;
+	return cmp_xy(a, b);
+}
+
+/* Sweeps points sorted by x and then by y, appending the points of every surface to
+ * its buffer, in ascending order of x */
+static void sweep_2d(eaf_sweep *S, const eaf_point *P, int n, eaf_buffer *out)
+{
+	int i, j, l, lo, hi, mid, r, from, to;
+	double old, v;
+
+	for (r = 0; r < S->nruns; r++)
+		S->best[r] = S->sorted[r] = DBL_MAX;
+	for (l = 0; l < S->nlevels; l++)
+		S->last[l] = DBL_MAX;
+
+	for (i = 0; i < n; i = j)
+	{
+		for (j = i; j < n && P[j].x == P[i].x; j++)
+		{
+			r = P[j].run;
+			old = S->best[r];
+			v = P[j].y;
+			if (v >= old)
+				continue;
+			S->best[r] = v;
+
+			// Some position holding the old value, and the first one above the new
+			for (lo = 0, hi = S->nruns - 1; lo < hi; )
+			{
+				mid = (lo + hi) / 2;
+				if (S->sorted[mid] < old)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			from = lo;
+			for (lo = 0, hi = from; lo < hi; )
+			{
+				mid = (lo + hi) / 2;
+				if (S->sorted[mid] <= v)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			to = lo;
+			memmove(S->sorted + to + 1, S->sorted + to, sizeof(double)*(from - to));
+			S->sorted[to] = v;
+		}
+
+		for (l = 0; l < S->nlevels; l++)
+		{
+			v = S->sorted[S->levels[l] - 1];
+			if (v < S->last[l])
+			{
+				buffer_push(&out[l], P[i].x, v, 0);
+				S->last[l] = v;
+			}
+		}
+	}
+}
+
+/* Staircases */
+
+static inline int height(const eaf_node *n)
+{
+	return n ? n->height : 0;
+}
+
+static inline void fix(eaf_node *n)
+{
+	int hl = height(n->left), hr = height(n->right);
+	n->height = 1 + ((hl > hr) ? hl : hr);
+}
+
+static eaf_node *rotate_right(eaf_node *n)
+{
+	eaf_node *l = n->left;
+	n->left = l->right;
+	l->right = n;
+	fix(n);
+	fix(l);
+	return l;
+}
+
+static eaf_node *rotate_left(eaf_node *n)
+{
+	eaf_node *r = n->right;
+	n->right = r->left;
+	r->left = n;
+	fix(n);
+	fix(r);
+	return r;
+}
+
+static eaf_node *balance(eaf_node *n)
+{
+	fix(n);
+	if (height(n->left) > height(n->right) + 1)
+	{
+		if (height(n->left->right) > height(n->left->left))
+			n->left = rotate_left(n->left);
+		return rotate_right(n);
+	}
+	if (height(n->right) > height(n->left) + 1)
+	{
+		if (height(n->right->left) > height(n->right->right))
+			n->right = rotate_right(n->right);
+		return rotate_left(n);
+	}
+	return n;
+}
+
+static eaf_node *stair_insert(eaf_node *n, eaf_node *v)
+{
+	if (!n)
+		return v;
+	if (v->x < n->x)
+		n->left = stair_insert(n->left, v);
+	else
+		n->right = stair_insert(n->right, v);
+	return balance(n);
+}
+
+// Unlinks the first node of a subtree
+static eaf_node *stair_remove_min(eaf_node *n, eaf_node **min)
+{
+	if (!n->left)
+	{
+		*min = n;
+		return n->right;
+	}
+	n->left = stair_remove_min(n->left, min);
+	return balance(n);
+}
+
+// Unlinks a node, which must be in the subtree
+static eaf_node *stair_remove(eaf_node *n, const eaf_node *v)
+{
+	eaf_node *min, *right;
+
+	if (v->x < n->x)
+		n->left = stair_remove(n->left, v);
+	else if (v->x > n->x)
+		n->right = stair_remove(n->right, v);
+	else
+	{
+		if (!n->right)
+			return n->left;
+		right = stair_remove_min(n->right, &min);
+		min->left = n->left;
+		min->right = right;
+		n = min;
+	}
+	return balance(n);
+}
+
+// Last point with x' <= x
+static eaf_node *stair_floor(eaf_node *n, double x)
+{
+	eaf_node *best = NULL;
+
+	while (n)
+	{
+		if (n->x <= x)
+		{
+			best = n;
+			n = n->right;
+		}
+		else
+			n = n->left;
+	}
+	return best;
+}
+
+static eaf_node *stair_first(eaf_node *n)
+{
+	while (n && n->left)
+		n = n->left;
+	return n;
+}
+
+// First point with y' < y (or y' <= y, if inclusive), as y descends along the staircase
+static eaf_node *stair_below(eaf_node *n, double y, int inclusive)
+{
+	eaf_node *best = NULL;
+
+	while (n)
+	{
+		if (n->y < y || (inclusive && n->y == y))
+		{
+			best = n;
+			n = n->left;
+		}
+		else
+			n = n->right;
+	}
+	return best;
+}
+
+// Point of the staircase that weakly dominates (x, y), if any
+static eaf_node *stair_covers(eaf_node *n, double x, double y)
+{
+	eaf_node *f = stair_floor(n, x);
+	return (f && f->y <= y) ? f : NULL;
+}
+
+/* Same as stair_covers, setting *prev, if there's no such point, to the last point with
+ * x' < x: where (x, y) would go */
+static eaf_node *stair_locate(eaf_node *n, double x, double y, eaf_node **prev)
+{
+	eaf_node *f = stair_floor(n, x);
+
+	if (f && f->y <= y)
+		return f;
+	*prev = (f && f->x == x) ? f->prev : f;
+	return NULL;
+}
+
+/* Adds a point no point of the staircase weakly dominates after prev, as given by
+ * stair_locate, removing the points it dominates. These come right after it, so the first one can just be moved to it,
+ * keeping its place in the tree. */
+static eaf_node *stair_add(eaf_pool *P, eaf_node *root, eaf_node *prev, double x,
+		double y)
+{
+	eaf_node *v, *d, *next;
+
+	v = prev ? prev->next : stair_first(root);
+	if (v && v->y >= y)
+	{
+		for (d = v->next; d && d->y >= y; d = next)
+		{
+			next = d->next;
+			root = stair_remove(root, d);
+			d->left = P->free;
+			P->free = d;
+		}
+		v->x = x;
+		v->y = y;
+		v->next = d;
+		if (d)
+			d->prev = v;
+		return root;
+	}
+
+	if (!P->free)
+	{
+		P->chunks = checked_realloc(P->chunks, sizeof(eaf_node*)*(P->nchunks + 1));
+		d = checked_realloc(NULL, sizeof(eaf_node)*EAF_CHUNK);
+		P->chunks[P->nchunks++] = d;
+		for (next = d; next < d + EAF_CHUNK; next++)
+		{
+			next->left = P->free;
+			P->free = next;
+		}
+	}
+	d = v;
+	v = P->free;
+	P->free = v->left;
+	v->x = x;
+	v->y = y;
+	v->height = 1;
+	v->left = v->right = NULL;
+	v->prev = prev;
+	v->next = d;
+	if (prev)
+		prev->next = v;
+	if (d)
+		d->prev = v;
+	return stair_insert(root, v);
+}
+
+/* Adds a point to the staircase of level k, and keeps it if the level is wanted */
+static void level_add(eaf_state *st, int k, eaf_node *prev, double x, double y)
+{
+	st->levels[k] = stair_add(&st->pool, st->levels[k], prev, x, y);
+	if (st->wanted[k])
+		buffer_push(&st->found[k], x, y, 0);
+}
+
+/* Point of the run's staircase, among those in st->near (see add_point), that weakly
+ * dominates (x, y), if any. The points must be checked in ascending order of x, from
+ * *j = 0 on. */
+static eaf_node *near_covers(const eaf_state *st, int *j, double x, double y)
+{
+	while (*j + 1 < st->nnear && st->near[*j + 1]->x <= x)
+		(*j)++;
+	if (st->nnear && st->near[*j]->x <= x && st->near[*j]->y <= y)
+		return st->near[*j];
+	return NULL;
+}
+
+/* Adding p to its run raises by one the number of runs attaining the points of A, the
+ * part of p's quadrant outside the run's region, so the new region of level k is the
+ * old one plus A's points in the region of level k-1. Its new minimal points are the
+ * points of level k-1's staircase clipped to p's quadrant that are neither in the
+ * run's region nor in level k's. They're found by walking along level k-1's staircase
+ * from p on; a point in either region skips, in a single search, every point above
+ * the one that covers it, so the walk only takes as many steps as points it finds and
+ * points of those regions it goes past. With dry set, it just tells whether A meets
+ * the region of level k-1. */
+static int level_update(eaf_state *st, int k, double px, double py, int dry)
+{
+	int j = 0, n = 0;
+	double cx, cy;
+	eaf_node *S = st->levels[k-1], *s, *last, *t, *prev = NULL;
+
+	// The region of level 0 is the whole plane, and clips to p's quadrant
+	s = (k > 1) ? stair_floor(S, px) : NULL;
+	if (k == 1 || (s && s->y <= py))
+	{
+		if (dry)
+			return 1;
+		if (stair_locate(st->levels[k], px, py, &prev))
+			return 0;
+		level_add(st, k, prev, px, py);
+		return 1;
+	}
+
+	/* Points before the last one with x <= px clip to dominated ones, and so do those
+	 * after the first one with y <= py */
+	if (!s)
+		s = stair_first(S);
+	last = stair_below(S, py, 1);
+	while (s)
+	{
+		cx = (s->x > px) ? s->x : px;
+		cy = (s->y > py) ? s->y : py;
+		t = near_covers(st, &j, cx, cy);
+		if (!t && !dry)
+			t = stair_locate(st->levels[k], cx, cy, &prev);
+		if (!t)
+		{
+			if (dry)
+				return 1;
+			level_add(st, k, prev, cx, cy);
+			n++;
+		}
+		if (s == last)
+			break;
+		if (t)
+		{
+			s = stair_below(S, t->y, 0);
+			if (last && s && s->x > last->x)
+				break;
+		}
+		else
+			s = s->next;
+	}
+	return n;
+}
+
+/* Adds a point to its run, updating the staircases of the levels it changes: those
+ * above the number of runs that attained it, up to the highest whose region A meets */
+static void add_point(eaf_state *st, const eaf_point *p)
+{
+	int lo, hi, mid, k;
+	eaf_node *t, *prev = NULL, *run = st->runs[p->run];
+
+	if (stair_locate(run, p->x, p->y, &prev))
+		return;
+
+	/* The only points of the run's staircase that can dominate points of p's quadrant
+	 * are the last one with x <= px, and the next ones up to the first with y <= py */
+	st->nnear = 0;
+	t = stair_floor(run, p->x);
+	for (t = t ? t : stair_first(run); t; t = t->next)
+	{
+		if (st->nnear == st->nearcap)
+		{
+			st->nearcap = st->nearcap ? 2*st->nearcap : 16;
+			st->near = checked_realloc(st->near, sizeof(eaf_node*)*st->nearcap);
+		}
+		st->near[st->nnear++] = t;
+		if (t->y <= p->y)
+			break;
+	}
+
+	for (lo = 0, hi = st->maxlevel; lo < hi; )
+	{
+		mid = (lo + hi + 1) / 2;
+		if (stair_covers(st->levels[mid], p->x, p->y))
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	k = lo + 1;
+	for (hi = st->maxlevel, lo = k; lo < hi; )
+	{
+		mid = (lo + hi + 1) / 2;
+		if (level_update(st, mid, p->x, p->y, 1))
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	// Lower levels must still be the old ones when a level is updated
+	for (; hi >= k; hi--)
+		level_update(st, hi, p->x, p->y, 0);
+
+	st->runs[p->run] = stair_add(&st->pool, run, prev, p->x, p->y);
+}
+
+static int cmp_x(const void *a, const void *b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x < y) ? -1 : (x > y);
+}
+
+/* Three-objective sweep: the points are added in ascending order of z, and the points
+ * found in every level's staircase while adding those with the same z that are still
+ * there afterwards are the new points of its surface */
+static void sweep_3d(eaf_state *st, const eaf_point *P, int n, const int *levels,
+		int nlevels, eaf_buffer *out)
+{
+	int i, j, l, k, m;
+	eaf_node *t;
+	eaf_buffer *F;
+
+	for (i = 0; i < n; i = j)
+	{
+		for (j = i; j < n && P[j].z == P[i].z; j++)
+			add_point(st, &P[j]);
+
+		for (k = 1; k <= st->maxlevel; k++)
+		{
+			F = &st->found[k];
+			for (m = 0, l = 0; l < F->len; l++)
+			{
+				t = stair_floor(st->levels[k], F->pts[2*l]);
+				if (t && t->x == F->pts[2*l] && t->y == F->pts[2*l + 1])
+				{
+					F->pts[2*m] = F->pts[2*l];
+					F->pts[2*m + 1] = F->pts[2*l + 1];
+					m++;
+				}
+			}
+			F->len = m;
+			if (m > 1)
+				qsort(F->pts, m, 2*sizeof(double), &cmp_x);
+		}
+		for (l = 0; l < nlevels; l++)
+		{
+			F = &st->found[levels[l]];
+			for (m = 0; m < F->len; m++)
+				buffer_push(&out[l], F->pts[2*m], F->pts[2*m + 1], P[i].z);
+		}
+		for (k = 1; k <= st->maxlevel; k++)
+			st->found[k].len = 0;
+	}
+}
+
+int eaf_percent_level(int nruns, double percent)
+{
+	int k = (int)ceil(percent*nruns/100);
+	if (k < 1)
+		k = 1;
+	if (k > nruns)
+		k = nruns;
+	return k;
+}
+
+eaf_t *attainment_surfaces_view(const frontview_t *runs, int nruns, const int *levels,
+		int nlevels)
+{
+	int i, j, l, r, n, vlen;
+	eaf_point *P;
+	eaf_buffer *out;
+	eaf_sweep S;
+	eaf_state st;
+	eaf_t *E;
+
+	vlen = (nruns > 0) ? runs[0].vlen : 0;
+	for (n = 0, r = 0; r < nruns; r++)
+	{
+		if (runs[r].vlen != vlen)
+			vlen = 0;
+		n += runs[r].len;
+	}
+	if (vlen < 2 || vlen > 3)
+	{
+		errno = EINVAL;
+		perror("MOOUtils: Error in data.");
+		exit(EXIT_FAILURE);
+	}
+	if (!levels)
+		nlevels = nruns;
+	for (l = 0; levels && l < nlevels; l++)
+	{
+		if (levels[l] < 1 || levels[l] > nruns)
+		{
+			errno = EINVAL;
+			perror("MOOUtils: Invalid option.");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	E = checked_realloc(NULL, sizeof(eaf_t));
+	E->nruns = nruns;
+	E->vlen = vlen;
+	E->nlevels = nlevels;
+	E->levels = new_vector_int(nlevels + 1);
+	E->lens = new_vector_int(nlevels + 1);
+	E->surfaces = checked_realloc(NULL, sizeof(double*)*nlevels);
+	for (l = 0; l < nlevels; l++)
+		E->levels[l] = levels ? levels[l] : l + 1;
+
+	P = checked_realloc(NULL, sizeof(eaf_point)*n);
+	for (i = 0, r = 0; r < nruns; r++)
+	{
+		for (j = 0; j < runs[r].len; j++, i++)
+		{
+			P[i].x = frontview_at(&runs[r], j, 0);
+			P[i].y = frontview_at(&runs[r], j, 1);
+			P[i].z = (vlen > 2) ? frontview_at(&runs[r], j, 2) : 0;
+			P[i].run = r;
+		}
+	}
+
+	out = checked_realloc(NULL, sizeof(eaf_buffer)*(nlevels + 1));
+	memset(out, 0, sizeof(eaf_buffer)*(nlevels + 1));
+	for (l = 0; l < nlevels; l++)
+		out[l].vlen = vlen;
+
+	if (vlen == 2)
+	{
+		S.nruns = nruns;
+		S.nlevels = nlevels;
+		S.levels = E->levels;
+		S.best = new_vector_double(nruns);
+		S.sorted = new_vector_double(nruns);
+		S.last = new_vector_double(nlevels + 1);
+		qsort(P, n, sizeof(eaf_point), &cmp_xy);
+		sweep_2d(&S, P, n, out);
+		free_vector(S.best);
+		free_vector(S.sorted);
+		free_vector(S.last);
+	}
+	else
+	{
+		st.maxlevel = 0;
+		for (l = 0; l < nlevels; l++)
+			if (E->levels[l] > st.maxlevel)
+				st.maxlevel = E->levels[l];
+		st.runs = checked_realloc(NULL, sizeof(eaf_node*)*(nruns + 1));
+		st.levels = checked_realloc(NULL, sizeof(eaf_node*)*(st.maxlevel + 1));
+		st.wanted = new_vector_int(st.maxlevel + 1);
+		st.found = checked_realloc(NULL, sizeof(eaf_buffer)*(st.maxlevel + 1));
+		memset(st.runs, 0, sizeof(eaf_node*)*(nruns + 1));
+		memset(st.levels, 0, sizeof(eaf_node*)*(st.maxlevel + 1));
+		memset(st.wanted, 0, sizeof(int)*(st.maxlevel + 1));
+		memset(st.found, 0, sizeof(eaf_buffer)*(st.maxlevel + 1));
+		memset(&st.pool, 0, sizeof(eaf_pool));
+		st.near = NULL;
+		st.nnear = st.nearcap = 0;
+		for (l = 0; l < nlevels; l++)
+			st.wanted[E->levels[l]] = 1;
+		for (l = 0; l <= st.maxlevel; l++)
+			st.found[l].vlen = 2;
+
+		qsort(P, n, sizeof(eaf_point), &cmp_z);
+		sweep_3d(&st, P, n, E->levels, nlevels, out);
+
+		for (l = 0; l < st.pool.nchunks; l++)
+			free(st.pool.chunks[l]);
+		for (l = 0; l <= st.maxlevel; l++)
+			free(st.found[l].pts);
+		free(st.pool.chunks);
+		free(st.near);
+		free(st.runs);
+		free(st.levels);
+		free_vector(st.wanted);
+		free(st.found);
+	}
+
+	for (l = 0; l < nlevels; l++)
+	{
+		E->lens[l] = out[l].len;
+		E->surfaces[l] = out[l].pts ? out[l].pts :
+				checked_realloc(NULL, sizeof(double)*vlen);
+	}
+
+	free(P);
+	free(out);
+	return E;
+}
+
+eaf_t *attainment_surfaces(double ***runs, const int *runlens, int nruns, int vlen,
+		const int *levels, int nlevels)
+{
+	int r;
+	eaf_t *E;
+	frontview_t *views = checked_realloc(NULL, sizeof(frontview_t)*(nruns > 0 ? nruns : 1));
+
+	for (r = 0; r < nruns; r++)
+		views[r] = frontview_matrix(runs[r], runlens[r], vlen);
+	E = attainment_surfaces_view(views, nruns, levels, nlevels);
+	free(views);
+	return E;
+}
+
+void free_eaf(eaf_t *E)
+{
+	int l;
+
+	if (!E)
+		return;
+	for (l = 0; l < E->nlevels; l++)
+		free(E->surfaces[l]);
+	free(E->surfaces);
+	free_vector(E->levels);
+	free_vector(E->lens);
+	free(E);
+}
@@ -32,62 +32,138 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <float.h>
+#include <stddef.h>
 
+#include "memalloc.h"
+#include "frontview.h"
+#include "nearest.h"
+#include "reffront.h"
 #include "epsilon.h"
 
-double epsilon(double **A, int Alen, double **B, int Blen, int vlen, epsilon_t method)
+/* Checking the values once is the same as checking every pair of vectors, and lets
+ * the main loop skip pairs */
+int epsilon_valid_multiplicative(const frontview_t *A, const frontview_t *B)
+{
+	int i, k;
+	double sign, v;
+
+	if (A->len + B->len == 0)
+		return 1;
+	for (k = 0; k < A->vlen; k++)
+	{
+		sign = (A->len > 0) ? frontview_at(A, 0, k) : frontview_at(B, 0, k);
+		for (i = 0; i < A->len + B->len; i++)
+		{
+			v = (i < A->len) ? frontview_at(A, i, k) : frontview_at(B, i - A->len, k);
+			if ( (v < 0 && sign > 0) || (v > 0 && sign < 0) || v == 0 )
+				return 0;
+		}
+	}
+	return 1;
+}
+
+int epsilon_valid_multiplicative_ref(const frontview_t *A, const reffront_t *B)
 {
-	size_t i, j, k;
-    double  eps, eps_j = 0.0, eps_k=0.0, eps_temp;
+	int i, k;
+	double v;
 
-    if (method == 0)
-	  eps = DBL_MIN;
-	else
-	  eps= 0;
+	if (B->len == 0)
+		return epsilon_valid_multiplicative(A, &B->view);
+	for (k = 0; k < B->vlen; k++)
+	{
+		if (!(B->min[k] > 0 || B->max[k] < 0))
+			return 0;
+		for (i = 0; i < A->len; i++)
+		{
+			v = frontview_at(A, i, k);
+			if (v == 0 || (v < 0) != (B->max[k] < 0))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+static void check_multiplicative(const frontview_t *A, const frontview_t *B)
+{
+	if (!epsilon_valid_multiplicative(A, B))
+	{
+		perror("MOOUtils: Error in data.");
+		exit(EXIT_FAILURE);
+	}
+}
 
+double epsilon_view_hint(const frontview_t *A, const frontview_t *B, epsilon_t method,
+		const int *nearest)
+{
+	int i, j, have_eps;
+	int Alen = A->len, Blen = B->len, vlen = A->vlen;
+	ptrdiff_t as = A->cstride, bs = B->cstride;
+	const double *a;
+	double eps, eps_j, eps_k;
+
+	switch (method)
+	{
+		case additive_e:
+			eps = DBL_MIN;
+			break;
+		case multiplicative_e:
+			eps = 0;
+			if (Alen > 0 && Blen > 0)
+				check_multiplicative(A, B);
+			break;
+		default:
+			perror("MOOUtils: Invalid option.");
+			exit(EXIT_FAILURE);
+	}
+	// No pairs at all (see epsilon.h)
+	if (Blen == 0)
+		return (Alen > 0) ? 0 : eps;
+
+	/* eps = max over A of (min over B of (max over the objectives)). Once eps is known
+	 * for some vectors of A, any other vector for which some vector of B needs no more
+	 * than eps can't change the result, so its search stops right there. A vector of B
+	 * close to each vector of A (e.g. the nearest one) makes for a good first guess. */
+	have_eps = 0;
 	for (i = 0; i < Alen; i++)
 	{
+		a = frontview_row(A, i);
+		eps_j = DBL_MAX;
+		if (nearest && nearest[i] >= 0)
+		{
+			eps_j = epsilon_pair(a, as, frontview_row(B, nearest[i]), bs, vlen, method,
+					DBL_MAX);
+			if (have_eps && eps_j <= eps)
+				continue;
+		}
 		for (j = 0; j < Blen; j++)
 		{
-			for (k = 0; k < vlen; k++)
+			eps_k = epsilon_pair(a, as, frontview_row(B, j), bs, vlen, method, eps_j);
+			if (eps_k < eps_j)
 			{
-				switch (method)
-				{
-					case additive_e:
-						eps_temp = B[j][k] - A[i][k];
-						break;
-					case multiplicative_e:
-						if ( (A[i][k] < 0 && B[j][k] > 0) ||
-								(A[i][k] > 0 && B[j][k] < 0) ||
-								(A[i][k] == 0 || B[j][k] == 0) )
-						{
-							perror("MOOUtils: Error in data.");
-							exit(EXIT_FAILURE);
-						}
-						eps_temp = B[j][k] / A[i][k];
-						break;
-					default:
-						perror("MOOUtils: Invalid option.");
-						exit(EXIT_FAILURE);
-				}
-				if (k == 0)
-					eps_k = eps_temp;
-				else if (eps_k < eps_temp)
-					eps_k = eps_temp;
+				eps_j = eps_k;
+				if (have_eps && eps_j <= eps)
+					break;
 			}
-	        if (j == 0)
-	          eps_j = eps_k;
-	        else if (eps_j > eps_k)
-	          eps_j = eps_k;
 		}
-		if (i == 0)
+		if (!have_eps || eps < eps_j)
 			eps = eps_j;
-		else if (eps < eps_j)
-		eps = eps_j;
+		have_eps = 1;
 	}
 	return eps;
 }
 
+double epsilon_view(const frontview_t *A, const frontview_t *B, epsilon_t method)
+{
+	return epsilon_view_hint(A, B, method, NULL);
+}
+
+double epsilon(double **A, int Alen, double **B, int Blen, int vlen, epsilon_t method)
+{
+	frontview_t a = frontview_matrix(A, Alen, vlen);
+	frontview_t b = frontview_matrix(B, Blen, vlen);
+	return epsilon_view(&a, &b, method);
+}
+
 double additive_epsilon(double **A, int Alen, double **B, int Blen, int vlen)
 {
 	return epsilon(A, Alen, B, Blen, vlen, additive_e);
@@ -97,3 +173,19 @@ double multiplicative_epsilon(double **A, int Alen, double **B, int Blen, int vl
 {
 	return epsilon(A, Alen, B, Blen, vlen, multiplicative_e);
 }
+
+double epsilon_ref(const frontview_t *A, const reffront_t *B, epsilon_t method)
+{
+	double res;
+	int *nearest;
+	double *dists;
+
+	// The prepared index gives a good guess for every vector of A at little cost
+	dists = new_vector_double(A->len + 1);
+	nearest = new_vector_int(A->len + 1);
+	reffront_nearest_squared_dists(B, A, 0, dists, nearest);
+	res = epsilon_view_hint(A, &B->view, method, nearest);
+	free_vector(dists);
+	free_vector(nearest);
+	return res;
+}
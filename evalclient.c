@@ -0,0 +1,196 @@
+/*
+ * evalclient.c
+ *
+ * Client side of the evaluation daemon's protocol. Calls are synchronous: each one
+ * sends a request and waits for its response.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "frontview.h"
+#include "suite.h"
+#include "evalclient.h"
+
+int eval_read_all(int fd, void *buf, size_t size)
+{
+	ssize_t n;
+	char *p = buf;
+
+	while (size > 0)
+	{
+		n = read(fd, p, size);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		p += n;
+		size -= n;
+	}
+	return 0;
+}
+
+int eval_write_all(int fd, const void *buf, size_t size)
+{
+	ssize_t n;
+	const char *p = buf;
+
+	while (size > 0)
+	{
+		// A peer that went away is reported as an error, not as SIGPIPE
+		n = send(fd, p, size, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		p += n;
+		size -= n;
+	}
+	return 0;
+}
+
+eval_client_t *eval_connect(const char *path)
+{
+	int fd;
+	struct sockaddr_un addr;
+	eval_client_t *C;
+
+	if (strlen(path) >= sizeof(addr.sun_path))
+	{
+		errno = ENAMETOOLONG;
+		return NULL;
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return NULL;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	C = malloc(sizeof(eval_client_t));
+	if (!C)
+	{
+		perror("MOOUtils: Out of memory when connecting to daemon");
+		exit(EXIT_FAILURE);
+	}
+	C->fd = fd;
+	C->next_id = 1;
+	return C;
+}
+
+/* Sends a request and waits for its response. The payload is either a view or a
+ * plain buffer of len bytes. */
+static int round_trip(eval_client_t *C, int op, const char *name, const frontview_t *front,
+		const void *bytes, size_t len, int mask, eval_response *resp)
+{
+	int i, k, ok;
+	size_t namelen = strlen(name);
+	double *rows;
+	eval_request_hdr h;
+
+	if (namelen > EVAL_NAME_MAX)
+		return EVAL_EPROTO;
+	if (front && (size_t)front->len*front->vlen > EVAL_MAX_VALUES)
+		return EVAL_EPROTO;
+
+	memset(&h, 0, sizeof(h));
+	h.magic = EVAL_MAGIC;
+	h.version = EVAL_VERSION;
+	h.op = op;
+	h.id = C->next_id++;
+	h.namelen = namelen;
+	h.len = front ? front->len : len;
+	h.vlen = front ? front->vlen : 0;
+	h.mask = mask;
+
+	ok = !eval_write_all(C->fd, &h, sizeof(h)) && !eval_write_all(C->fd, name, namelen);
+	if (ok && front)
+	{
+		// Views may have any layout, but the payload is always row-major
+		rows = malloc(sizeof(double)*((size_t)front->len*front->vlen + 1));
+		if (!rows)
+		{
+			perror("MOOUtils: Out of memory when sending front");
+			exit(EXIT_FAILURE);
+		}
+		for (i = 0; i < front->len; i++)
+			for (k = 0; k < front->vlen; k++)
+				rows[(size_t)i*front->vlen + k] = frontview_at(front, i, k);
+		ok = !eval_write_all(C->fd, rows, sizeof(double)*front->len*front->vlen);
+		free(rows);
+	}
+	else if (ok && bytes)
+	{
+		ok = !eval_write_all(C->fd, bytes, len);
+	}
+	if (!ok || eval_read_all(C->fd, resp, sizeof(eval_response)) || resp->id != h.id)
+		return EVAL_EIO;
+	return resp->status;
+}
+
+int eval_put_front(eval_client_t *C, const char *name, const frontview_t *front)
+{
+	eval_response resp;
+	return round_trip(C, EVAL_OP_PUT, name, front, NULL, 0, 0, &resp);
+}
+
+int eval_load_front(eval_client_t *C, const char *name, const char *path)
+{
+	eval_response resp;
+	return round_trip(C, EVAL_OP_LOAD, name, NULL, path, strlen(path), 0, &resp);
+}
+
+int eval_drop_front(eval_client_t *C, const char *name)
+{
+	eval_response resp;
+	return round_trip(C, EVAL_OP_DROP, name, NULL, NULL, 0, 0, &resp);
+}
+
+int eval_indicators(eval_client_t *C, const char *name, const frontview_t *front,
+		int mask, indicator_results_t *results)
+{
+	int status;
+	eval_response resp;
+
+	status = round_trip(C, EVAL_OP_EVAL, name, front, NULL, 0, mask, &resp);
+	if (status == EVAL_OK)
+		*results = resp.results;
+	return status;
+}
+
+void eval_disconnect(eval_client_t *C)
+{
+	if (!C)
+		return;
+	close(C->fd);
+	free(C);
+}
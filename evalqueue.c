@@ -0,0 +1,272 @@
+/*
+ * evalqueue.c
+ *
+ * Asynchronous evaluation queue. Submissions are kept in a bounded FIFO list, and
+ * workers take them one at a time. A ticket is shared by its submitter and the worker
+ * computing it, and freed when both are done with it.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "reffront.h"
+#include "suite.h"
+#include "evalqueue.h"
+
+struct eval_ticket
+{
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int refs;                  /* one for the submitter, one until the evaluation is done */
+	int done;
+	int status;
+	indicator_results_t results;
+
+	frontview_t view;
+	double *data;              /* copy of the set, if it was copied */
+	const reffront_t *R;
+	int mask;
+	eval_callback_t callback;
+	void *arg;
+	struct eval_ticket *next;
+};
+
+struct eval_queue
+{
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+	eval_ticket_t *head, *tail;
+	int count;
+	int capacity;
+	int draining;              /* workers leave once the queue is empty */
+	int nworkers;
+	pthread_t *workers;
+};
+
+static void ticket_free(eval_ticket_t *t)
+{
+	pthread_mutex_destroy(&t->lock);
+	pthread_cond_destroy(&t->cond);
+	free(t->data);
+	free(t);
+}
+
+static void ticket_unref(eval_ticket_t *t)
+{
+	int refs;
+
+	pthread_mutex_lock(&t->lock);
+	refs = --t->refs;
+	pthread_mutex_unlock(&t->lock);
+	if (refs == 0)
+		ticket_free(t);
+}
+
+static int evaluate(eval_ticket_t *t, indicator_results_t *results)
+{
+	int status = indicator_suite_check(&t->view, t->R, t->mask);
+
+	memset(results, 0, sizeof(indicator_results_t));
+	if (status == EVAL_OK)
+		indicator_suite_ref(&t->view, t->R, t->mask, results);
+	return status;
+}
+
+static void *worker_main(void *arg)
+{
+	eval_queue_t *Q = arg;
+	eval_ticket_t *t;
+	indicator_results_t results;
+	int status;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&Q->lock);
+		while (!Q->head && !Q->draining)
+			pthread_cond_wait(&Q->not_empty, &Q->lock);
+		if (!Q->head)
+		{
+			pthread_mutex_unlock(&Q->lock);
+			break;
+		}
+		t = Q->head;
+		Q->head = t->next;
+		if (!Q->head)
+			Q->tail = NULL;
+		Q->count--;
+		pthread_cond_signal(&Q->not_full);
+		pthread_mutex_unlock(&Q->lock);
+
+		status = evaluate(t, &results);
+		if (t->callback)
+			t->callback(t, status, &results, t->arg);
+
+		pthread_mutex_lock(&t->lock);
+		t->status = status;
+		t->results = results;
+		t->done = 1;
+		pthread_cond_broadcast(&t->cond);
+		pthread_mutex_unlock(&t->lock);
+		ticket_unref(t);
+	}
+	return NULL;
+}
+
+eval_queue_t *eval_queue_start(int nworkers, int capacity)
+{
+	int i;
+	eval_queue_t *Q;
+
+	Q = checked_malloc(sizeof(eval_queue_t));
+	memset(Q, 0, sizeof(eval_queue_t));
+	pthread_mutex_init(&Q->lock, NULL);
+	pthread_cond_init(&Q->not_empty, NULL);
+	pthread_cond_init(&Q->not_full, NULL);
+	Q->capacity = (capacity > 0) ? capacity : 1;
+
+	Q->nworkers = (nworkers > 0) ? nworkers : 1;
+	Q->workers = checked_malloc(sizeof(pthread_t)*Q->nworkers);
+	for (i = 0; i < Q->nworkers; i++)
+	{
+		if (pthread_create(&Q->workers[i], NULL, &worker_main, Q))
+		{
+			perror("MOOUtils: Error creating worker thread");
+			exit(EXIT_FAILURE);
+		}
+	}
+	return Q;
+}
+
+eval_ticket_t *eval_queue_submit(eval_queue_t *Q, const frontview_t *front,
+		const reffront_t *truefront, int mask, int flags, eval_callback_t callback,
+		void *arg)
+{
+	int i, k;
+	eval_ticket_t *t;
+
+	t = checked_malloc(sizeof(eval_ticket_t));
+	memset(t, 0, sizeof(eval_ticket_t));
+	pthread_mutex_init(&t->lock, NULL);
+	pthread_cond_init(&t->cond, NULL);
+	t->refs = 2;
+	t->R = truefront;
+	t->mask = mask & INDICATOR_ALL;
+	t->callback = callback;
+	t->arg = arg;
+	t->view = *front;
+	if (flags & EVAL_COPY)
+	{
+		t->data = checked_malloc(sizeof(double)*(size_t)front->len*front->vlen);
+		for (i = 0; i < front->len; i++)
+			for (k = 0; k < front->vlen; k++)
+				t->data[(size_t)i*front->vlen + k] = frontview_at(front, i, k);
+		t->view = frontview_rowmajor(t->data, front->len, front->vlen);
+	}
+
+	pthread_mutex_lock(&Q->lock);
+	while (Q->count >= Q->capacity && !(flags & EVAL_NOWAIT))
+		pthread_cond_wait(&Q->not_full, &Q->lock);
+	if (Q->count >= Q->capacity)
+	{
+		pthread_mutex_unlock(&Q->lock);
+		ticket_free(t);
+		errno = EAGAIN;
+		return NULL;
+	}
+	if (Q->tail)
+		Q->tail->next = t;
+	else
+		Q->head = t;
+	Q->tail = t;
+	Q->count++;
+	pthread_cond_signal(&Q->not_empty);
+	pthread_mutex_unlock(&Q->lock);
+	return t;
+}
+
+int eval_queue_pending(eval_queue_t *Q)
+{
+	int count;
+
+	pthread_mutex_lock(&Q->lock);
+	count = Q->count;
+	pthread_mutex_unlock(&Q->lock);
+	return count;
+}
+
+void eval_queue_stop(eval_queue_t *Q)
+{
+	int i;
+
+	pthread_mutex_lock(&Q->lock);
+	Q->draining = 1;
+	pthread_cond_broadcast(&Q->not_empty);
+	pthread_mutex_unlock(&Q->lock);
+	for (i = 0; i < Q->nworkers; i++)
+		pthread_join(Q->workers[i], NULL);
+
+	pthread_mutex_destroy(&Q->lock);
+	pthread_cond_destroy(&Q->not_empty);
+	pthread_cond_destroy(&Q->not_full);
+	free(Q->workers);
+	free(Q);
+}
+
+int eval_ticket_poll(eval_ticket_t *t, indicator_results_t *results)
+{
+	int status = -1;
+
+	pthread_mutex_lock(&t->lock);
+	if (t->done)
+	{
+		status = t->status;
+		if (results)
+			*results = t->results;
+	}
+	pthread_mutex_unlock(&t->lock);
+	return status;
+}
+
+int eval_ticket_wait(eval_ticket_t *t, indicator_results_t *results)
+{
+	int status;
+
+	pthread_mutex_lock(&t->lock);
+	while (!t->done)
+		pthread_cond_wait(&t->cond, &t->lock);
+	status = t->status;
+	if (results)
+		*results = t->results;
+	pthread_mutex_unlock(&t->lock);
+	return status;
+}
+
+void eval_ticket_release(eval_ticket_t *t)
+{
+	ticket_unref(t);
+}
@@ -0,0 +1,604 @@
+/*
+ * evalserver.c
+ *
+ * Evaluation server. One thread accepts connections, one thread per connection reads
+ * and parses requests, and a pool of workers evaluates the queued sets. Fronts are
+ * reference counted, so one can be replaced or dropped while evaluations against it
+ * are still running.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "reffront.h"
+#include "suite.h"
+#include "evalclient.h"
+#include "evalserver.h"
+
+// Longest path accepted by EVAL_OP_LOAD
+#define EVAL_PATH_MAX 4096
+
+typedef struct front_entry
+{
+	char name[EVAL_NAME_MAX + 1];
+	reffront_t *R;
+	int refs;                  /* one for the cache, one per user */
+	struct front_entry *next;
+}front_entry;
+
+typedef struct conn
+{
+	int fd;
+	int refs;                  /* one for the reading thread, one per queued job */
+	pthread_mutex_t wlock;     /* serializes the responses */
+	struct eval_server *S;
+	struct conn *prev, *next;
+}conn;
+
+typedef struct job
+{
+	conn *c;
+	uint32_t id;
+	int mask;
+	char name[EVAL_NAME_MAX + 1];
+	frontview_t view;
+	struct job *next;
+}job;
+
+struct eval_server
+{
+	char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+	int listen_fd;
+	int stopping;              /* no more connections are accepted (under conn_lock) */
+	int draining;              /* workers leave once the queue is empty (under queue_lock) */
+	pthread_t acceptor;
+	int nworkers;
+	pthread_t *workers;
+
+	pthread_mutex_t cache_lock;
+	front_entry *fronts;
+
+	pthread_mutex_t queue_lock;
+	pthread_cond_t queue_cond;
+	pthread_cond_t not_full;
+	job *head, *tail;
+	int count;                 /* jobs queued, or whose payload is being read */
+	int capacity;
+
+	pthread_mutex_t conn_lock;
+	pthread_cond_t conn_cond;
+	conn *conns;               /* connections with a live reading thread */
+};
+
+/* Front cache */
+
+static front_entry *cache_get(eval_server_t *S, const char *name)
+{
+	front_entry *e;
+
+	pthread_mutex_lock(&S->cache_lock);
+	for (e = S->fronts; e; e = e->next)
+		if (!strcmp(e->name, name))
+			break;
+	if (e)
+		e->refs++;
+	pthread_mutex_unlock(&S->cache_lock);
+	return e;
+}
+
+static void cache_release(eval_server_t *S, front_entry *e)
+{
+	int refs;
+
+	pthread_mutex_lock(&S->cache_lock);
+	refs = --e->refs;
+	pthread_mutex_unlock(&S->cache_lock);
+	if (refs == 0)
+	{
+		free_reffront(e->R);
+		free(e);
+	}
+}
+
+// Unlinks the front with the given name, returning it (still holding the cache's ref)
+static front_entry *cache_unlink(eval_server_t *S, const char *name)
+{
+	front_entry *e, **pe;
+
+	for (pe = &S->fronts; *pe; pe = &(*pe)->next)
+	{
+		if (!strcmp((*pe)->name, name))
+		{
+			e = *pe;
+			*pe = e->next;
+			return e;
+		}
+	}
+	return NULL;
+}
+
+void eval_server_put(eval_server_t *S, const char *name, reffront_t *R)
+{
+	front_entry *e, *old;
+
+	e = checked_malloc(sizeof(front_entry));
+	snprintf(e->name, sizeof(e->name), "%s", name);
+	e->R = R;
+	e->refs = 1;
+
+	pthread_mutex_lock(&S->cache_lock);
+	old = cache_unlink(S, e->name);
+	e->next = S->fronts;
+	S->fronts = e;
+	pthread_mutex_unlock(&S->cache_lock);
+	if (old)
+		cache_release(S, old);
+}
+
+static int cache_drop(eval_server_t *S, const char *name)
+{
+	front_entry *e;
+
+	pthread_mutex_lock(&S->cache_lock);
+	e = cache_unlink(S, name);
+	pthread_mutex_unlock(&S->cache_lock);
+	if (!e)
+		return EVAL_ENOFRONT;
+	cache_release(S, e);
+	return EVAL_OK;
+}
+
+/* Connections */
+
+static void conn_release(conn *c)
+{
+	int refs;
+
+	pthread_mutex_lock(&c->S->conn_lock);
+	refs = --c->refs;
+	pthread_mutex_unlock(&c->S->conn_lock);
+	if (refs == 0)
+	{
+		close(c->fd);
+		pthread_mutex_destroy(&c->wlock);
+		free(c);
+	}
+}
+
+static void respond(conn *c, uint32_t id, int status, const indicator_results_t *results)
+{
+	eval_response resp;
+
+	memset(&resp, 0, sizeof(resp));
+	resp.id = id;
+	resp.status = status;
+	if (results)
+		resp.results = *results;
+	// A client that went away simply doesn't get its response
+	pthread_mutex_lock(&c->wlock);
+	eval_write_all(c->fd, &resp, sizeof(resp));
+	pthread_mutex_unlock(&c->wlock);
+}
+
+/* Reads the row-major payload of a request into a new view */
+static int read_front(conn *c, const eval_request_hdr *h, frontview_t *view)
+{
+	double *data;
+
+	data = checked_malloc(sizeof(double)*h->len*h->vlen);
+	if (eval_read_all(c->fd, data, sizeof(double)*h->len*h->vlen))
+	{
+		free(data);
+		return -1;
+	}
+	*view = frontview_rowmajor(data, h->len, h->vlen);
+	return 0;
+}
+
+/* Takes a place in the queue for a job, waiting for room if it's full. The reading
+ * thread stops reading its connection meanwhile, so a client can't pile up jobs faster
+ * than they're evaluated; the place is taken before reading the payload, so neither
+ * can it pile up memory. */
+static void reserve(eval_server_t *S)
+{
+	pthread_mutex_lock(&S->queue_lock);
+	while (S->count >= S->capacity)
+		pthread_cond_wait(&S->not_full, &S->queue_lock);
+	S->count++;
+	pthread_mutex_unlock(&S->queue_lock);
+}
+
+static void unreserve(eval_server_t *S)
+{
+	pthread_mutex_lock(&S->queue_lock);
+	S->count--;
+	pthread_cond_signal(&S->not_full);
+	pthread_mutex_unlock(&S->queue_lock);
+}
+
+// Queues a job in the place taken with reserve
+static void enqueue(eval_server_t *S, job *j)
+{
+	pthread_mutex_lock(&S->queue_lock);
+	j->next = NULL;
+	if (S->tail)
+		S->tail->next = j;
+	else
+		S->head = j;
+	S->tail = j;
+	pthread_cond_signal(&S->queue_cond);
+	pthread_mutex_unlock(&S->queue_lock);
+}
+
+/* Handles one request. Returns -1 if the connection must be closed (it went away, or
+ * it's out of sync). */
+static int handle_request(conn *c, const eval_request_hdr *h)
+{
+	eval_server_t *S = c->S;
+	char name[EVAL_NAME_MAX + 1];
+	char path[EVAL_PATH_MAX + 1];
+	frontview_t view;
+	reffront_t *R;
+	job *j;
+
+	if (h->magic != EVAL_MAGIC || h->version != EVAL_VERSION || h->namelen > EVAL_NAME_MAX)
+	{
+		respond(c, h->id, EVAL_EPROTO, NULL);
+		return -1;
+	}
+	if (eval_read_all(c->fd, name, h->namelen))
+		return -1;
+	name[h->namelen] = '\0';
+
+	switch (h->op)
+	{
+	case EVAL_OP_PUT:
+	case EVAL_OP_EVAL:
+		if (h->len == 0 || h->vlen == 0 || h->len > EVAL_MAX_VALUES ||
+				h->vlen > EVAL_MAX_VALUES / h->len)
+		{
+			respond(c, h->id, EVAL_EPROTO, NULL);
+			return -1;
+		}
+		if (h->op == EVAL_OP_EVAL)
+			reserve(S);
+		if (read_front(c, h, &view))
+		{
+			if (h->op == EVAL_OP_EVAL)
+				unreserve(S);
+			return -1;
+		}
+		if (h->op == EVAL_OP_PUT)
+		{
+			R = reffront_prepare(&view);
+			free(view.base);
+			eval_server_put(S, name, R);
+			respond(c, h->id, EVAL_OK, NULL);
+			break;
+		}
+		j = checked_malloc(sizeof(job));
+		j->c = c;
+		j->id = h->id;
+		j->mask = h->mask & INDICATOR_ALL;
+		memcpy(j->name, name, h->namelen + 1);
+		j->view = view;
+		pthread_mutex_lock(&S->conn_lock);
+		c->refs++;
+		pthread_mutex_unlock(&S->conn_lock);
+		enqueue(S, j);
+		break;
+	case EVAL_OP_LOAD:
+		if (h->len > EVAL_PATH_MAX)
+		{
+			respond(c, h->id, EVAL_EPROTO, NULL);
+			return -1;
+		}
+		if (eval_read_all(c->fd, path, h->len))
+			return -1;
+		path[h->len] = '\0';
+		R = reffront_map(path);
+		if (R)
+			eval_server_put(S, name, R);
+		// Files that are there but aren't valid prepared fronts are a data error
+		respond(c, h->id, R ? EVAL_OK : (errno == EINVAL) ? EVAL_EDATA : EVAL_EFILE, NULL);
+		break;
+	case EVAL_OP_DROP:
+		respond(c, h->id, cache_drop(S, name), NULL);
+		break;
+	default:
+		respond(c, h->id, EVAL_EPROTO, NULL);
+		return -1;
+	}
+	return 0;
+}
+
+static void *conn_main(void *arg)
+{
+	conn *c = arg;
+	eval_server_t *S = c->S;
+	eval_request_hdr h;
+
+	while (!eval_read_all(c->fd, &h, sizeof(h)) && !handle_request(c, &h))
+		;
+
+	shutdown(c->fd, SHUT_RD);
+	pthread_mutex_lock(&S->conn_lock);
+	if (c->prev)
+		c->prev->next = c->next;
+	else
+		S->conns = c->next;
+	if (c->next)
+		c->next->prev = c->prev;
+	pthread_cond_broadcast(&S->conn_cond);
+	pthread_mutex_unlock(&S->conn_lock);
+	conn_release(c);
+	return NULL;
+}
+
+static void *acceptor_main(void *arg)
+{
+	eval_server_t *S = arg;
+	int fd, stopping;
+	conn *c;
+	pthread_t thread;
+
+	for (;;)
+	{
+		fd = accept(S->listen_fd, NULL, NULL);
+		if (fd < 0)
+		{
+			pthread_mutex_lock(&S->conn_lock);
+			stopping = S->stopping;
+			pthread_mutex_unlock(&S->conn_lock);
+			if (stopping)
+				break;
+			if (errno == EINTR || errno == ECONNABORTED || errno == EMFILE ||
+					errno == ENFILE)
+				continue;
+			perror("MOOUtils: Error accepting connection");
+			break;
+		}
+
+		c = checked_malloc(sizeof(conn));
+		c->fd = fd;
+		c->refs = 1;
+		c->S = S;
+		c->prev = NULL;
+		pthread_mutex_init(&c->wlock, NULL);
+		pthread_mutex_lock(&S->conn_lock);
+		if (S->stopping)
+		{
+			pthread_mutex_unlock(&S->conn_lock);
+			conn_release(c);
+			break;
+		}
+		c->next = S->conns;
+		if (S->conns)
+			S->conns->prev = c;
+		S->conns = c;
+		pthread_mutex_unlock(&S->conn_lock);
+
+		if (pthread_create(&thread, NULL, &conn_main, c))
+		{
+			perror("MOOUtils: Error creating connection thread");
+			exit(EXIT_FAILURE);
+		}
+		pthread_detach(thread);
+	}
+	return NULL;
+}
+
+/* Workers */
+
+static void evaluate(const front_entry *e, job *j)
+{
+	int status;
+	indicator_results_t results;
+
+	if (!e)
+	{
+		respond(j->c, j->id, EVAL_ENOFRONT, NULL);
+	}
+	else if ((status = indicator_suite_check(&j->view, e->R, j->mask)) != EVAL_OK)
+	{
+		respond(j->c, j->id, status, NULL);
+	}
+	else
+	{
+		indicator_suite_ref(&j->view, e->R, j->mask, &results);
+		respond(j->c, j->id, EVAL_OK, &results);
+	}
+}
+
+static void *worker_main(void *arg)
+{
+	eval_server_t *S = arg;
+	int n;
+	job *batch, *j, **pj, *last;
+	front_entry *e;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&S->queue_lock);
+		while (!S->head && !S->draining)
+			pthread_cond_wait(&S->queue_cond, &S->queue_lock);
+		if (!S->head)
+		{
+			pthread_mutex_unlock(&S->queue_lock);
+			break;
+		}
+
+		/* Take the oldest job, along with the next ones against the same front, up to
+		 * a whole batch */
+		batch = last = S->head;
+		S->head = batch->next;
+		n = 1;
+		for (pj = &S->head; *pj && n < EVAL_BATCH; )
+		{
+			j = *pj;
+			if (!strcmp(j->name, batch->name))
+			{
+				*pj = j->next;
+				last->next = j;
+				last = j;
+				n++;
+			}
+			else
+			{
+				pj = &j->next;
+			}
+		}
+		last->next = NULL;
+		S->tail = NULL;
+		for (j = S->head; j; j = j->next)
+			S->tail = j;
+		S->count -= n;
+		pthread_cond_broadcast(&S->not_full);
+		pthread_mutex_unlock(&S->queue_lock);
+
+		e = cache_get(S, batch->name);
+		while (batch)
+		{
+			j = batch;
+			batch = j->next;
+			evaluate(e, j);
+			conn_release(j->c);
+			free(j->view.base);
+			free(j);
+		}
+		if (e)
+			cache_release(S, e);
+	}
+	return NULL;
+}
+
+eval_server_t *eval_server_start(const char *path, int nworkers, int capacity)
+{
+	int i, err;
+	struct sockaddr_un addr;
+	eval_server_t *S;
+
+	if (strlen(path) >= sizeof(addr.sun_path))
+	{
+		errno = ENAMETOOLONG;
+		return NULL;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+
+	S = checked_malloc(sizeof(eval_server_t));
+	memset(S, 0, sizeof(eval_server_t));
+	strcpy(S->path, path);
+	S->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (S->listen_fd < 0 || bind(S->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) ||
+			listen(S->listen_fd, SOMAXCONN))
+	{
+		err = errno;
+		if (S->listen_fd >= 0)
+			close(S->listen_fd);
+		free(S);
+		errno = err;
+		return NULL;
+	}
+
+	pthread_mutex_init(&S->cache_lock, NULL);
+	pthread_mutex_init(&S->queue_lock, NULL);
+	pthread_cond_init(&S->queue_cond, NULL);
+	pthread_cond_init(&S->not_full, NULL);
+	S->capacity = (capacity > 0) ? capacity : 1;
+	pthread_mutex_init(&S->conn_lock, NULL);
+	pthread_cond_init(&S->conn_cond, NULL);
+
+	S->nworkers = (nworkers > 0) ? nworkers : 1;
+	S->workers = checked_malloc(sizeof(pthread_t)*S->nworkers);
+	for (i = 0; i < S->nworkers; i++)
+	{
+		if (pthread_create(&S->workers[i], NULL, &worker_main, S))
+		{
+			perror("MOOUtils: Error creating worker thread");
+			exit(EXIT_FAILURE);
+		}
+	}
+	if (pthread_create(&S->acceptor, NULL, &acceptor_main, S))
+	{
+		perror("MOOUtils: Error creating acceptor thread");
+		exit(EXIT_FAILURE);
+	}
+	return S;
+}
+
+void eval_server_stop(eval_server_t *S)
+{
+	int i;
+	conn *c;
+	front_entry *e;
+
+	// Stop accepting connections
+	pthread_mutex_lock(&S->conn_lock);
+	S->stopping = 1;
+	pthread_mutex_unlock(&S->conn_lock);
+	shutdown(S->listen_fd, SHUT_RDWR);
+	pthread_join(S->acceptor, NULL);
+	close(S->listen_fd);
+	unlink(S->path);
+
+	// Wake up every reading thread, and wait for them to finish
+	pthread_mutex_lock(&S->conn_lock);
+	for (c = S->conns; c; c = c->next)
+		shutdown(c->fd, SHUT_RD);
+	while (S->conns)
+		pthread_cond_wait(&S->conn_cond, &S->conn_lock);
+	pthread_mutex_unlock(&S->conn_lock);
+
+	// Workers drain the queue before leaving
+	pthread_mutex_lock(&S->queue_lock);
+	S->draining = 1;
+	pthread_cond_broadcast(&S->queue_cond);
+	pthread_mutex_unlock(&S->queue_lock);
+	for (i = 0; i < S->nworkers; i++)
+		pthread_join(S->workers[i], NULL);
+
+	while (S->fronts)
+	{
+		e = S->fronts;
+		S->fronts = e->next;
+		cache_release(S, e);
+	}
+
+	pthread_mutex_destroy(&S->cache_lock);
+	pthread_mutex_destroy(&S->queue_lock);
+	pthread_cond_destroy(&S->queue_cond);
+	pthread_cond_destroy(&S->not_full);
+	pthread_mutex_destroy(&S->conn_lock);
+	pthread_cond_destroy(&S->conn_cond);
+	free(S->workers);
+	free(S);
+}
@@ -14,12 +14,14 @@
 #include "gamma.h"
 #include "epsilon.h"
 #include "moutils.h"
+#include "suite.h"
 
 int read_set(FILE *input, int setlen, int nobj, double ***pset);
 
 int main (int argc, char *argv[])
 {
-	double **pset, **tfront, **filtered_set, gd, sp, gs, ep;
+	double **pset, **tfront, **filtered_set;
+	indicator_results_t res;
 	size_t psetlen, tfrontlen, fsetlen, nobj;
 	FILE *input;
 	char chr;
@@ -75,10 +77,11 @@ int main (int argc, char *argv[])
 	// Note that epsilons is used here as an unary indicator, though it is originally meant to be
 	// a binary one. The binary epsilon indicator is used to compare two reference sets against each
 	// each and not a set against the true Pareto front, as is done here.
-	gd = generational_distance(filtered_set, fsetlen, tfront, tfrontlen, nobj);
-	sp = spread(filtered_set, fsetlen, tfront, tfrontlen);
-	gs = generalized_spread(filtered_set, fsetlen, tfront, tfrontlen, nobj);
-	ep = epsilon(filtered_set, fsetlen, tfront, tfrontlen, nobj, multiplicative_e);
+	// The indicators could be calculated one by one (generational_distance, spread,
+	// generalized_spread and epsilon), but asking for all of them at once lets the
+	// library share the work common to all of them.
+	indicator_suite(filtered_set, fsetlen, tfront, tfrontlen, nobj,
+			INDICATOR_GD | INDICATOR_SPREAD | INDICATOR_GSPREAD | INDICATOR_EPSILON_MUL, &res);
 
 	// Free memory used by arrays
 	free_matrix((void**)tfront, tfrontlen);
@@ -88,7 +91,7 @@ int main (int argc, char *argv[])
 	printf( "I_GD: %2.4f\n"
 			"I_S: %2.4f\n"
 			"I_GS: %2.4f\n"
-			"I_epsilon: %2.4f\n", gd, sp, gs, ep);
+			"I_epsilon: %2.4f\n", res.gd, res.spread, res.gspread, res.epsilon_mul);
 
 	return (EXIT_SUCCESS);
 }
@@ -0,0 +1,221 @@
+/*
+ * frontfile.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "frontfile.h"
+
+#define FRONTFILE_MAGIC "MOOFRNT"
+#define FRONTFILE_BYTEORDER 0x01020304u
+
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteorder;
+	int32_t vlen;
+	int32_t has_bounds;
+	int64_t len;
+}frontfile_header;
+
+static void file_error(const char *msg, int err)
+{
+	errno = err;
+	perror(msg);
+	exit(EXIT_FAILURE);
+}
+
+void frontfile_save(const frontview_t *front, const char *path, int with_bounds)
+{
+	int i, k, ok;
+	FILE *f;
+	frontfile_header h;
+	double *row, *min, *max;
+
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, FRONTFILE_MAGIC, sizeof(h.magic));
+	h.version = FRONTFILE_VERSION;
+	h.byteorder = FRONTFILE_BYTEORDER;
+	h.vlen = front->vlen;
+	h.has_bounds = with_bounds ? 1 : 0;
+	h.len = front->len;
+
+	f = fopen(path, "wb");
+	if (!f)
+		file_error("MOOUtils: Error opening front file", errno);
+	ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	if (with_bounds)
+	{
+		min = new_vector_double(front->vlen);
+		max = new_vector_double(front->vlen);
+		view_bounds(front, min, max);
+		ok = ok && fwrite(min, sizeof(double), front->vlen, f) == (size_t)front->vlen;
+		ok = ok && fwrite(max, sizeof(double), front->vlen, f) == (size_t)front->vlen;
+		free_vector(min);
+		free_vector(max);
+	}
+	row = new_vector_double(front->vlen);
+	for (i = 0; ok && i < front->len; i++)
+	{
+		for (k = 0; k < front->vlen; k++)
+			row[k] = frontview_at(front, i, k);
+		ok = fwrite(row, sizeof(double), front->vlen, f) == (size_t)front->vlen;
+	}
+	free_vector(row);
+	if (fclose(f) || !ok)
+		file_error("MOOUtils: Error writing front file", errno);
+}
+
+static void *reader_main(void *arg)
+{
+	frontstream_t *S = arg;
+	int b, n;
+
+	for (b = 0; ; b ^= 1)
+	{
+		pthread_mutex_lock(&S->lock);
+		while (S->full[b] && !S->stop)
+			pthread_cond_wait(&S->cond, &S->lock);
+		if (S->stop)
+		{
+			pthread_mutex_unlock(&S->lock);
+			break;
+		}
+		pthread_mutex_unlock(&S->lock);
+
+		// The disk is read without holding the lock
+		n = (S->remaining < S->chunklen) ? (int)S->remaining : S->chunklen;
+		if (n > 0 && fread(S->buf[b], sizeof(double)*S->vlen, n, S->file) != (size_t)n)
+			file_error("MOOUtils: Error reading front file",
+					ferror(S->file) ? errno : EINVAL);
+		S->remaining -= n;
+
+		pthread_mutex_lock(&S->lock);
+		S->count[b] = n;
+		S->full[b] = 1;
+		pthread_cond_broadcast(&S->cond);
+		pthread_mutex_unlock(&S->lock);
+		// An empty chunk marks the end of the file
+		if (n == 0)
+			break;
+	}
+	return NULL;
+}
+
+frontstream_t *frontstream_open(const char *path, int chunklen)
+{
+	frontstream_t *S;
+	frontfile_header h;
+
+	S = malloc(sizeof(frontstream_t));
+	if (!S)
+		file_error("MOOUtils: Out of memory when opening front file", ENOMEM);
+	memset(S, 0, sizeof(frontstream_t));
+
+	S->file = fopen(path, "rb");
+	if (!S->file)
+		file_error("MOOUtils: Error opening front file", errno);
+	if (fread(&h, sizeof(h), 1, S->file) != 1 ||
+			memcmp(h.magic, FRONTFILE_MAGIC, sizeof(h.magic)) ||
+			h.version != FRONTFILE_VERSION || h.byteorder != FRONTFILE_BYTEORDER ||
+			h.vlen <= 0 || h.len < 0)
+		file_error("MOOUtils: Error in front file", EINVAL);
+	S->vlen = h.vlen;
+	S->len = h.len;
+	S->has_bounds = h.has_bounds;
+	if (h.has_bounds)
+	{
+		S->min = new_vector_double(h.vlen);
+		S->max = new_vector_double(h.vlen);
+		if (fread(S->min, sizeof(double), h.vlen, S->file) != (size_t)h.vlen ||
+				fread(S->max, sizeof(double), h.vlen, S->file) != (size_t)h.vlen)
+			file_error("MOOUtils: Error in front file", EINVAL);
+	}
+
+	S->chunklen = (chunklen > 0) ? chunklen : FRONTSTREAM_CHUNK;
+	S->remaining = h.len;
+	S->buf[0] = new_vector_double((size_t)S->chunklen*S->vlen);
+	S->buf[1] = new_vector_double((size_t)S->chunklen*S->vlen);
+	S->held = -1;
+	pthread_mutex_init(&S->lock, NULL);
+	pthread_cond_init(&S->cond, NULL);
+	if (pthread_create(&S->reader, NULL, &reader_main, S))
+		file_error("MOOUtils: Error creating reader thread", errno);
+	return S;
+}
+
+int frontstream_next(frontstream_t *S, frontview_t *chunk)
+{
+	int n, b = S->cur;
+
+	pthread_mutex_lock(&S->lock);
+	// The previous chunk is done with, so the reader can refill its buffer
+	if (S->held >= 0)
+	{
+		S->full[S->held] = 0;
+		S->held = -1;
+		pthread_cond_broadcast(&S->cond);
+	}
+	while (!S->full[b])
+		pthread_cond_wait(&S->cond, &S->lock);
+	n = S->count[b];
+	pthread_mutex_unlock(&S->lock);
+
+	if (n == 0)
+		return 0;
+	*chunk = frontview_rowmajor(S->buf[b], n, S->vlen);
+	S->held = b;
+	S->cur = b ^ 1;
+	return n;
+}
+
+void frontstream_close(frontstream_t *S)
+{
+	if (!S)
+		return;
+	pthread_mutex_lock(&S->lock);
+	S->stop = 1;
+	pthread_cond_broadcast(&S->cond);
+	pthread_mutex_unlock(&S->lock);
+	pthread_join(S->reader, NULL);
+
+	fclose(S->file);
+	pthread_mutex_destroy(&S->lock);
+	pthread_cond_destroy(&S->cond);
+	free_vector(S->buf[0]);
+	free_vector(S->buf[1]);
+	if (S->has_bounds)
+	{
+		free_vector(S->min);
+		free_vector(S->max);
+	}
+	free(S);
+}
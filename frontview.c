@@ -0,0 +1,61 @@
+/*
+ * frontview.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+
+#include "frontview.h"
+
+frontview_t frontview_matrix(double **set, int setlen, int vlen)
+{
+	frontview_t v;
+	v.base = NULL;
+	v.rows = set;
+	v.rstride = 0;
+	v.cstride = 1;
+	v.len = setlen;
+	v.vlen = vlen;
+	return v;
+}
+
+frontview_t frontview_rowmajor(double *data, int len, int vlen)
+{
+	return frontview_strided(data, len, vlen, vlen, 1);
+}
+
+frontview_t frontview_colmajor(double *data, int len, int vlen)
+{
+	return frontview_strided(data, len, vlen, 1, len);
+}
+
+frontview_t frontview_strided(double *base, int len, int vlen,
+		ptrdiff_t rstride, ptrdiff_t cstride)
+{
+	frontview_t v;
+	v.base = base;
+	v.rows = NULL;
+	v.rstride = rstride;
+	v.cstride = cstride;
+	v.len = len;
+	v.vlen = vlen;
+	return v;
+}
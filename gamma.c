@@ -30,81 +30,440 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <float.h>
 #include <math.h>
 
 #include "memalloc.h"
+#include "frontview.h"
 #include "moutils.h"
+#include "nearest.h"
+#include "reffront.h"
+#include "qfront.h"
+#include "frontfile.h"
+#include "gamma.h"
 
-double generational_distance(double **front, int frontlen,
-		double **truefront, int truefrontlen, int vlen)
+/* Sum of the squared distances from every vector in X to its nearest vector in Y */
+static double sum_closed_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale)
 {
-	size_t i;
-	double res, sum;
-	double *min_values, *max_values;
-	double **norm_front, **norm_truefront;
+	int i;
+	double sum, *dists;
+
+	sum = 0;
+	dists = new_vector_double(X->len);
+	nearest_squared_dists(X, Y, scale, 0, dists, NULL);
+	for (i = 0; i < X->len; i++)
+		sum += dists[i];
+	free_vector(dists);
+	return sum;
+}
 
-	// Normalize fronts
-	min_values = get_min_values(truefront, truefrontlen, vlen);
-	max_values = get_max_values(truefront, truefrontlen, vlen);
-	norm_front = normalize_front(front, frontlen, vlen,
-			min_values, max_values);
-	norm_truefront = normalize_front(truefront, truefrontlen, vlen,
-			min_values, max_values);
+double scaled_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale)
+{
+	double res, sum;
 
 	/* Perform calculations. The generational distance accumulates the euclidian
 	 * distances from every vector in the reference set to the nearest vector in
 	 * the true Pareto front. Note that, according to all references, the distances
 	 * aren't actually euclidian, but euclidian powered by 2, so we use simple
 	 * squared distances here. */
-	sum = 0;
-	for (i = 0; i < frontlen; i++)
-	{
-		sum += dist_closed_point(norm_front[i], vlen, norm_truefront, truefrontlen);
-	}
-	res = (sqrt(sum))/frontlen;
-
-	// Free used arrays
-	free_matrix((void**)norm_front, frontlen);
-	free_matrix((void**)norm_truefront, truefrontlen);
-	free_vector(min_values);
-	free_vector(max_values);
+	sum = sum_closed_dists(front, truefront, scale);
+	res = (sqrt(sum))/front->len;
 
 	return (res);
 }
 
-double inverted_generational_distance(double **front, int frontlen,
-		double **truefront, int truefrontlen, int vlen)
+double scaled_inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale)
 {
-	size_t i;
 	double res, sum;
-	double *min_values, *max_values;
-	double **norm_front, **norm_truefront;
-
-	// Normalize fronts
-	min_values = get_min_values(truefront, truefrontlen, vlen);
-	max_values = get_max_values(truefront, truefrontlen, vlen);
-	norm_front = normalize_front(front, frontlen, vlen,
-			min_values, max_values);
-	norm_truefront = normalize_front(truefront, truefrontlen, vlen,
-			min_values, max_values);
 
 	/* Perform calculations. The inverted generational distance accumulates the
 	 * euclidian distances from every vector in the true Pareto front to the nearest
 	 * vector in the reference set. Note that, according to all references, the
 	 * distances aren't actually euclidian, but euclidian powered by 2, so we use
 	 * simple squared distances here. */
+	sum = sum_closed_dists(truefront, front, scale);
+	res = (sqrt(sum))/truefront->len;
+
+	return (res);
+}
+
+double generational_distance_view(const frontview_t *front, const frontview_t *truefront)
+{
+	double res, *scale;
+
+	/* Normalization is applied lazily: distances are measured on the fly using the
+	 * true front's scale factors, so no normalized copies of the fronts are made. */
+	scale = view_norm_scale(truefront);
+	res = scaled_generational_distance_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront)
+{
+	double res, *scale;
+
+	// Lazy normalization (see generational_distance_view)
+	scale = view_norm_scale(truefront);
+	res = scaled_inverted_generational_distance_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double generational_distance(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	return generational_distance_view(&f, &t);
+}
+
+double inverted_generational_distance(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	return inverted_generational_distance_view(&f, &t);
+}
+
+/* Sum of the squared modified distances from every vector in X to its nearest vector
+ * in Y (see nearest_plus_squared_dists) */
+static double sum_plus_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int side)
+{
+	int i;
+	double sum, *dists;
+
 	sum = 0;
-	for (i = 0; i < truefrontlen; i++)
+	dists = new_vector_double(X->len);
+	nearest_plus_squared_dists(X, Y, scale, side, dists);
+	for (i = 0; i < X->len; i++)
+		sum += dists[i];
+	free_vector(dists);
+	return sum;
+}
+
+double scaled_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale)
+{
+	/* Every vector of the set is compared to the true front vectors it is worse than:
+	 * only the components where the true front's vector is lower count */
+	double sum = sum_plus_dists(front, truefront, scale, -1);
+	return (sqrt(sum))/front->len;
+}
+
+double scaled_inverted_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale)
+{
+	// Only the components where the set's vector is greater count
+	double sum = sum_plus_dists(truefront, front, scale, 1);
+	return (sqrt(sum))/truefront->len;
+}
+
+double generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront)
+{
+	double res, *scale;
+
+	// Lazy normalization (see generational_distance_view)
+	scale = view_norm_scale(truefront);
+	res = scaled_generational_distance_plus_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double inverted_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront)
+{
+	double res, *scale;
+
+	scale = view_norm_scale(truefront);
+	res = scaled_inverted_generational_distance_plus_view(front, truefront, scale);
+	free_vector(scale);
+	return (res);
+}
+
+double generational_distance_plus(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	return generational_distance_plus_view(&f, &t);
+}
+
+double inverted_generational_distance_plus(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	return inverted_generational_distance_plus_view(&f, &t);
+}
+
+double generational_distance_ref(const frontview_t *front, const reffront_t *truefront)
+{
+	int i;
+	double sum, *dists;
+
+	// Same as scaled_generational_distance_view, searching through the prepared index
+	dists = new_vector_double(front->len);
+	reffront_nearest_squared_dists(truefront, front, 0, dists, NULL);
+	sum = 0;
+	for (i = 0; i < front->len; i++)
+		sum += dists[i];
+	free_vector(dists);
+	return (sqrt(sum))/front->len;
+}
+
+double inverted_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront)
+{
+	int i;
+	double sum, *dists, *ordered;
+
+	/* The distances are accumulated in the order of the original true front, so the
+	 * result is exactly the one of inverted_generational_distance_view */
+	dists = new_vector_double(truefront->len);
+	ordered = new_vector_double(truefront->len);
+	nearest_squared_dists(&truefront->view, front, truefront->scale, 0, dists, NULL);
+	reffront_original_order(truefront, dists, ordered);
+	sum = 0;
+	for (i = 0; i < truefront->len; i++)
+		sum += ordered[i];
+	free_vector(dists);
+	free_vector(ordered);
+	return (sqrt(sum))/truefront->len;
+}
+
+/* Sums approximate squared distances and their lower bounds, and turns both sums into
+ * the relative error bound of the square root of the first one */
+static double approx_sum(const double *dists, const double *lower, int len,
+		double *bound)
+{
+	int i;
+	double sum, lsum;
+
+	sum = lsum = 0;
+	for (i = 0; i < len; i++)
+	{
+		sum += dists[i];
+		lsum += lower[i];
+	}
+	if (bound)
+		*bound = (lsum > 0 && sum > lsum) ? sqrt(sum/lsum) - 1 : 0;
+	return sum;
+}
+
+double approx_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, double eps, double *bound)
+{
+	double sum, *scale, *dists, *lower;
+	nearest_index_t *I;
+
+	scale = view_norm_scale(truefront);
+	dists = new_vector_double(front->len);
+	lower = new_vector_double(front->len);
+	I = nearest_index_build(truefront, scale);
+	nearest_index_query_approx(I, front, eps, dists, lower);
+	sum = approx_sum(dists, lower, front->len, bound);
+	free_nearest_index(I);
+	free_vector(scale);
+	free_vector(dists);
+	free_vector(lower);
+	return (sqrt(sum))/front->len;
+}
+
+double approx_inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, double eps, double *bound)
+{
+	double sum, *scale, *dists, *lower;
+	nearest_index_t *I;
+
+	scale = view_norm_scale(truefront);
+	dists = new_vector_double(truefront->len);
+	lower = new_vector_double(truefront->len);
+	I = nearest_index_build(front, scale);
+	nearest_index_query_approx(I, truefront, eps, dists, lower);
+	sum = approx_sum(dists, lower, truefront->len, bound);
+	free_nearest_index(I);
+	free_vector(scale);
+	free_vector(dists);
+	free_vector(lower);
+	return (sqrt(sum))/truefront->len;
+}
+
+double approx_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront, double eps, double *bound)
+{
+	double sum, *dists, *lower;
+
+	dists = new_vector_double(front->len);
+	lower = new_vector_double(front->len);
+	reffront_nearest_squared_dists_approx(truefront, front, eps, dists, lower);
+	sum = approx_sum(dists, lower, front->len, bound);
+	free_vector(dists);
+	free_vector(lower);
+	return (sqrt(sum))/front->len;
+}
+
+double approx_inverted_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront, double eps, double *bound)
+{
+	double sum, *dists, *lower, *odists, *olower;
+	nearest_index_t *I;
+
+	// Accumulated in the original order, as in inverted_generational_distance_ref
+	dists = new_vector_double(truefront->len);
+	lower = new_vector_double(truefront->len);
+	odists = new_vector_double(truefront->len);
+	olower = new_vector_double(truefront->len);
+	I = nearest_index_build(front, truefront->scale);
+	nearest_index_query_approx(I, &truefront->view, eps, dists, lower);
+	reffront_original_order(truefront, dists, odists);
+	reffront_original_order(truefront, lower, olower);
+	sum = approx_sum(odists, olower, truefront->len, bound);
+	free_nearest_index(I);
+	free_vector(dists);
+	free_vector(lower);
+	free_vector(odists);
+	free_vector(olower);
+	return (sqrt(sum))/truefront->len;
+}
+
+double generational_distance_quant(const frontview_t *front, const qfront_t *truefront,
+		double *bound)
+{
+	int i;
+	double sum, *dists;
+
+	dists = new_vector_double(front->len);
+	qfront_nearest_squared_dists(truefront, front, dists);
+	sum = 0;
+	for (i = 0; i < front->len; i++)
+		sum += dists[i];
+	free_vector(dists);
+	/* Every distance is off by at most dist_error, so the root of the sum of their
+	 * squares is off by at most sqrt(len) times that */
+	if (bound)
+		*bound = truefront->dist_error / sqrt(front->len);
+	return (sqrt(sum))/front->len;
+}
+
+double inverted_generational_distance_quant(const frontview_t *front,
+		const qfront_t *truefront, double *bound)
+{
+	int i, first, n;
+	double sum, *chunk, *dists;
+	frontview_t view;
+	nearest_index_t *I;
+
+	/* The set is indexed once, and the true front is decoded a chunk at a time and
+	 * searched through it, as in streaming_inverted_generational_distance */
+	I = nearest_index_build(front, truefront->scale);
+	chunk = new_vector_double((size_t)QFRONT_CHUNK*truefront->vlen);
+	dists = new_vector_double(QFRONT_CHUNK);
+	sum = 0;
+	for (first = 0; first < truefront->len; first += n)
+	{
+		n = (truefront->len - first < QFRONT_CHUNK) ? truefront->len - first : QFRONT_CHUNK;
+		qfront_decode(truefront, first, n, chunk);
+		view = frontview_rowmajor(chunk, n, truefront->vlen);
+		nearest_index_query(I, &view, 0, dists, NULL);
+		for (i = 0; i < n; i++)
+			sum += dists[i];
+	}
+	free_nearest_index(I);
+	free_vector(chunk);
+	free_vector(dists);
+	if (bound)
+		*bound = truefront->dist_error / sqrt(truefront->len);
+	return (sqrt(sum))/truefront->len;
+}
+
+double streaming_inverted_generational_distance(const frontview_t *front,
+		const char *truefront_path, int chunklen)
+{
+	int i, j, n, vlen = front->vlen;
+	int64_t len;
+	double sum, res;
+	double *min, *max, *cmin, *cmax, *scale, *dists;
+	frontview_t chunk;
+	frontstream_t *S;
+	nearest_index_t *I;
+
+	S = frontstream_open(truefront_path, chunklen);
+	if (S->vlen != vlen || S->len == 0)
 	{
-		sum += dist_closed_point(norm_truefront[i], vlen, norm_front, frontlen);
+		errno = EINVAL;
+		perror("MOOUtils: Error in data.");
+		exit(EXIT_FAILURE);
 	}
-	res = (sqrt(sum))/truefrontlen;
+	len = S->len;
 
-	// Free used arrays
-	free_matrix((void**)norm_front, frontlen);
-	free_matrix((void**)norm_truefront, truefrontlen);
-	free_vector(min_values);
-	free_vector(max_values);
+	/* Normalization bounds come from the file's header, or else from a first pass
+	 * over the whole file */
+	min = new_vector_double(vlen);
+	max = new_vector_double(vlen);
+	if (S->has_bounds)
+	{
+		for (j = 0; j < vlen; j++)
+		{
+			min[j] = S->min[j];
+			max[j] = S->max[j];
+		}
+	}
+	else
+	{
+		cmin = new_vector_double(vlen);
+		cmax = new_vector_double(vlen);
+		for (j = 0; j < vlen; j++)
+		{
+			min[j] = DBL_MAX;
+			max[j] = -DBL_MAX;
+		}
+		while (frontstream_next(S, &chunk))
+		{
+			view_bounds(&chunk, cmin, cmax);
+			for (j = 0; j < vlen; j++)
+			{
+				min[j] = (cmin[j] < min[j]) ? cmin[j] : min[j];
+				max[j] = (cmax[j] > max[j]) ? cmax[j] : max[j];
+			}
+		}
+		free_vector(cmin);
+		free_vector(cmax);
+		frontstream_close(S);
+		S = frontstream_open(truefront_path, chunklen);
+	}
+	// Same scale factors view_norm_scale would give for the whole true front
+	scale = new_vector_double(vlen);
+	for (j = 0; j < vlen; j++)
+		scale[j] = 1.0 / (max[j] - min[j]);
+
+	/* The set is indexed once, and every chunk of the true front is searched through
+	 * it while the next one is being read. Distances are accumulated in the order of
+	 * the file, so the result is exactly the one of the in-memory version. */
+	I = nearest_index_build(front, scale);
+	dists = new_vector_double(S->chunklen);
+	sum = 0;
+	while ((n = frontstream_next(S, &chunk)) > 0)
+	{
+		nearest_index_query(I, &chunk, 0, dists, NULL);
+		for (i = 0; i < n; i++)
+			sum += dists[i];
+	}
+	res = (sqrt(sum))/len;
 
+	frontstream_close(S);
+	free_nearest_index(I);
+	free_vector(dists);
+	free_vector(scale);
+	free_vector(min);
+	free_vector(max);
 	return (res);
 }
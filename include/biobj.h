@@ -0,0 +1,80 @@
+/*
+ * biobj.h
+ *
+ * Specialized nearest vector searches for bi-objective sets
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BIOBJ_H_
+#define BIOBJ_H_
+
+#include "frontview.h"
+
+/* A bi-objective set sorted in lexicographical order, with its coordinates stored as
+ * contiguous x,y pairs. A non-dominated set sorted this way is a staircase: the second
+ * objective never increases along it, which the searches take advantage of. Any set
+ * can be used, though; staircase tells whether that's the case. Distances are
+ * normalized on the fly with the scale factors sx and sy. */
+typedef struct
+{
+	int len;
+	int staircase;
+	double sx, sy;
+	double *xy;     /* 2*len sorted coordinates */
+	int *index;     /* index in the original set of each sorted vector (NULL: same order) */
+}staircase_t;
+
+/* Sorts a bi-objective set (only the first two components of the vectors are used).
+ * The returned structure must be freed with free_staircase.
+ *
+ * ARGS: view of the set, scale factors to normalize the set with (or NULL)
+ * RTRN: the sorted set */
+staircase_t *staircase_build(const frontview_t *set, const double *scale);
+
+/* Finds the nearest vector of a sorted set to a query point (given as is; the sorted
+ * set's scale factors are applied to the differences). A binary search locates the
+ * query along the first objective, and the search expands from there until the
+ * distance along either objective alone exceeds the best distance found.
+ *
+ * ARGS: sorted set, query coordinates, 1 to ignore vectors equal to the query,
+ *       output for the index of the nearest vector in the original set (or NULL)
+ * RTRN: the squared distance to the nearest vector, DBL_MAX if there is none */
+double staircase_nearest(const staircase_t *S, double x, double y, int distinct,
+		int *nearest);
+
+/* Approximate version of staircase_nearest: each way of the search also stops once the
+ * vectors left can't be nearer than the best distance found divided by (1+eps), so the
+ * distance returned is at most (1+eps) times the exact one.
+ *
+ * ARGS: sorted set, query vector, relative tolerance, output for a lower bound of the
+ *       exact squared distance (or NULL), output for the index of the vector found in
+ *       the original set (or NULL)
+ * RTRN: the squared distance to the vector found, DBL_MAX if the set is empty */
+double staircase_nearest_approx(const staircase_t *S, double x, double y, double eps,
+		double *lower, int *nearest);
+
+/* Frees the memory used by a sorted set
+ *
+ * ARGS: sorted set */
+void free_staircase(staircase_t *S);
+
+#endif /* BIOBJ_H_ */
@@ -0,0 +1,52 @@
+/*
+ * blockdist.h
+ *
+ * Blocked point-to-set minimum distance engine, meant for many-objective sets
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BLOCKDIST_H_
+#define BLOCKDIST_H_
+
+#include "frontview.h"
+
+/* Number of objectives from which the indicators switch from one-pair-at-a-time
+ * searches to the blocked engine */
+#define BLOCKDIST_MIN_VLEN 8
+
+/* Option flags for block_min_squared_dists */
+#define BLOCKDIST_EXACT    0x1 /* recompute the distance to each winning vector exactly */
+#define BLOCKDIST_DISTINCT 0x2 /* ignore vectors equal to the query (as dist_nearest_point) */
+
+/* Computes, for every vector in X, the squared distance to the nearest vector in Y.
+ * Distances are obtained tile by tile as |x|^2 + |y|^2 - 2x.y, so most of the work is
+ * done by a vectorizable inner product kernel over cache-sized blocks of Y.
+ * If scale is not NULL, the vectors are normalized on the fly (see scaled_squared_dist).
+ * Queries with no valid candidate get DBL_MAX.
+ *
+ * ARGS: view of set X, view of set Y, scale factors (or NULL), option flags,
+ *       output array for the distances, output array for the indices of the nearest
+ *       vectors in Y (or NULL), both of X's length  */
+void block_min_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int flags, double *mindists, int *nearest);
+
+#endif /* BLOCKDIST_H_ */
@@ -0,0 +1,70 @@
+/*
+ * cpudispatch.h
+ *
+ * Selection of the instruction set variant of the vector kernels at run time
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CPUDISPATCH_H_
+#define CPUDISPATCH_H_
+
+/* Kernels are only compiled in several variants by GCC-compatible compilers targeting
+ * x86-64. Elsewhere, the generic variant is the only one. */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MOO_ISA_VARIANTS 1
+#define MOO_TARGET_AVX2 __attribute__((target("avx2")))
+#define MOO_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define MOO_ISA_VARIANTS 0
+#endif
+
+/* Environment variable that forces a variant, for benchmarking: "generic" (or "sse2"),
+ * "avx2" or "avx512". Variants the processor can't run are never selected. */
+#define MOO_ISA_ENV "MOOUTILS_ISA"
+
+/* Instruction set variants, from the least to the most demanding. All of them give
+ * exactly the same results. */
+typedef enum
+{
+	moo_isa_generic,  /* baseline of the target (SSE2 on x86-64) */
+	moo_isa_avx2,
+	moo_isa_avx512
+}moo_isa_t;
+
+/* Returns the most demanding variant the processor can run
+ *
+ * RTRN: instruction set variant */
+moo_isa_t moo_cpu_isa(void);
+
+/* Returns the variant the kernels use: the one forced through MOO_ISA_ENV, if any and
+ * if the processor can run it, or else moo_cpu_isa's. It's chosen on the first call.
+ *
+ * RTRN: instruction set variant */
+moo_isa_t moo_active_isa(void);
+
+/* Returns the name of a variant, as accepted in MOO_ISA_ENV
+ *
+ * ARGS: instruction set variant
+ * RTRN: its name */
+const char *moo_isa_name(moo_isa_t isa);
+
+#endif /* CPUDISPATCH_H_ */
@@ -0,0 +1,76 @@
+/*
+ * crowding.h
+ *
+ * Crowding distance of the vectors of a front, as used by NSGA-II
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CROWDING_H_
+#define CROWDING_H_
+
+#include <stdint.h>
+
+#include "frontview.h"
+
+/* Scratch memory for crowding distance calculations. It grows as needed and is kept
+ * between calls, so an algorithm computing the crowding distances of its fronts every
+ * generation doesn't allocate anything once the largest front has been seen.
+ * A workspace must not be shared by concurrent calls. */
+typedef struct
+{
+	int capacity;
+	uint64_t *keys, *keys2;  /* sort keys, and room for the radix sort's passes */
+	int *order, *order2;     /* positions of the vectors, sorted along with the keys */
+	int *counts;             /* histograms of the radix sort */
+}crowding_workspace_t;
+
+/* Creates an empty workspace. The returned structure must be freed with
+ * free_crowding_workspace.
+ *
+ * RTRN: the workspace */
+crowding_workspace_t *new_crowding_workspace(void);
+
+/* Frees the memory used by a workspace
+ *
+ * ARGS: workspace */
+void free_crowding_workspace(crowding_workspace_t *W);
+
+/* Calculates the crowding distance of every vector of a front: the sum, over the
+ * objectives, of the distance between the two neighbours of the vector when the front
+ * is sorted by that objective, divided by the objective's range. The vectors holding
+ * the minimum or the maximum value of any objective get INFINITY (so do all of them if
+ * the front has less than 3 vectors), and objectives with a null range add nothing.
+ * Each objective is sorted once, with a radix sort over the values' bit patterns; it's
+ * stable, so ties are ordered by position in the front.
+ *
+ * ARGS: view of the front, workspace (or NULL to use a temporary one), output array
+ *       with the front's length for the crowding distances */
+void crowding_distance_view(const frontview_t *front, crowding_workspace_t *W,
+		double *dists);
+
+/* Calculates the crowding distance of every vector of a front
+ *
+ * ARGS: set of vectors, set length, vectors length (number of objectives), output
+ *       array with the set's length for the crowding distances */
+void crowding_distance(double **front, int frontlen, int vlen, double *dists);
+
+#endif /* CROWDING_H_ */
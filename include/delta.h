@@ -24,6 +24,9 @@
 #ifndef DELTA_H_
 #define DELTA_H_
 
+#include "frontview.h"
+#include "reffront.h"
+
 /* Calculates Deb's spread indicator from a set of non-dominated two-dimensional vectors
  *
  * ARGS: set of non-dominated vectors, set length, true pareto front, true front length
@@ -66,4 +69,41 @@ double generalized_spread_original(double **front, int frontlen,
 		double **truefront, int truefrontlen, int vlen);
 
 
+/* View versions of the indicators above. The vectors length is taken from the views,
+ * which may have different layouts (see frontview.h).
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front */
+double spread_view(const frontview_t *front, const frontview_t *truefront);
+
+double generalized_spread_view(const frontview_t *front, const frontview_t *truefront);
+
+double generalized_spread_original_view(const frontview_t *front, const frontview_t *truefront);
+
+
+/* Same as the view versions, but normalizing with the given scale factors (see
+ * get_norm_scale) instead of computing them. Meant for evaluating several indicators
+ * against the same true front.
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front,
+ *       the true front's scale factors (or NULL to skip normalization) */
+double scaled_spread_view(const frontview_t *front, const frontview_t *truefront,
+		const double *scale);
+
+double scaled_generalized_spread_view(const frontview_t *front, const frontview_t *truefront,
+		const double *scale);
+
+double scaled_generalized_spread_original_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale);
+
+/* Same as the view versions, against a prepared true front (see reffront.h)
+ *
+ * ARGS: view of the set of non-dominated vectors, prepared true pareto front */
+double spread_ref(const frontview_t *front, const reffront_t *truefront);
+
+double generalized_spread_ref(const frontview_t *front, const reffront_t *truefront);
+
+double generalized_spread_original_ref(const frontview_t *front,
+		const reffront_t *truefront);
+
+
 #endif /* DELTA_H_ */
@@ -0,0 +1,86 @@
+/*
+ * dommatrix.h
+ *
+ * Bit-parallel computation of the pairwise Pareto dominance relation of a set
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMMATRIX_H_
+#define DOMMATRIX_H_
+
+#include <stdint.h>
+
+#include "frontview.h"
+
+/* Pairwise dominance relation of a set of n vectors (minimization of objectives).
+ * Row i of the bit matrix holds one bit per vector of the set, and bit j of row i is
+ * set if vector i dominates vector j. Rows are padded to a whole number of 64-bit words.
+ *
+ * Derived data, filled along with the matrix:
+ *  - dom_count[i]:   number of vectors that dominate vector i
+ *  - dominates_count[i]: number of vectors dominated by vector i
+ *  - dominated_by[dominated_by_start[i] .. dominated_by_start[i+1]-1]: indices of the
+ *    vectors that dominate vector i, in increasing order */
+typedef struct
+{
+	int n;
+	int words;
+	uint64_t *bits;
+	int *dom_count;
+	int *dominates_count;
+	int *dominated_by_start;
+	int *dominated_by;
+}dommatrix_t;
+
+/* Computes the dominance matrix of a set of vectors. Points are sorted once per
+ * objective, and the "better or equal" sets of every objective are intersected using
+ * word-level operations, so the cost is O(vlen*n^2/64) instead of O(vlen*n^2).
+ * The returned structure must be freed with free_dommatrix.
+ *
+ * ARGS: set of vectors, set length, vectors length (number of objectives)
+ * RTRN: the dominance matrix of the set */
+dommatrix_t *dominance_matrix(double **set, int setlen, int vlen);
+
+
+/* View version of dominance_matrix
+ *
+ * ARGS: view of the set
+ * RTRN: the dominance matrix of the set */
+dommatrix_t *dominance_matrix_view(const frontview_t *set);
+
+
+/* Checks a single entry of a dominance matrix
+ *
+ * ARGS: dominance matrix, index of vector a, index of vector b
+ * RTRN: 1 if a dominates b, 0 otherwise */
+static inline int dommatrix_dominates(const dommatrix_t *M, int a, int b)
+{
+	return (int)((M->bits[(size_t)a*M->words + (b >> 6)] >> (b & 63)) & 1);
+}
+
+
+/* Frees the memory used by a dominance matrix
+ *
+ * ARGS: dominance matrix */
+void free_dommatrix(dommatrix_t *M);
+
+#endif /* DOMMATRIX_H_ */
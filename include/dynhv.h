@@ -0,0 +1,96 @@
+/*
+ * dynhv.h
+ *
+ * Bi-objective hypervolume of a set kept up to date under insertions and deletions
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DYNHV_H_
+#define DYNHV_H_
+
+/* A non-dominated bi-objective set (minimization of objectives) and the hypervolume it
+ * dominates up to a reference point. The vectors form a staircase, kept in an AVL tree
+ * in lexicographical order (see lexicographical_compare), where every vector owns the
+ * rectangle between itself, the next vector's first objective and the reference
+ * point's second one. Subtrees keep the sum of their rectangles, so the hypervolume is
+ * the root's sum. The exclusive contribution of every vector (the area lost if it's
+ * removed) is kept in a min-heap. Insertions and deletions take O(log n) time, plus
+ * O(log n) for every vector an insertion dominates. */
+typedef struct dynhv dynhv_t;
+
+/* Creates an empty set
+ *
+ * ARGS: reference point (2 values)
+ * RTRN: the set, to be freed with free_dynhv */
+dynhv_t *new_dynhv(const double *ref);
+
+/* Frees the memory used by a set
+ *
+ * ARGS: set */
+void free_dynhv(dynhv_t *H);
+
+/* Inserts a vector, removing the vectors it dominates. Vectors weakly dominated by one
+ * of the set, or not strictly better than the reference point in both objectives,
+ * add nothing and are left out.
+ *
+ * ARGS: set, vector (2 values)
+ * RTRN: number of vectors removed, or -1 if the vector was left out */
+int dynhv_insert(dynhv_t *H, const double *v);
+
+/* Removes a vector
+ *
+ * ARGS: set, vector (2 values)
+ * RTRN: 1 if it was in the set, 0 otherwise */
+int dynhv_remove(dynhv_t *H, const double *v);
+
+/* Returns the number of vectors in the set
+ *
+ * ARGS: set
+ * RTRN: number of vectors */
+int dynhv_len(const dynhv_t *H);
+
+/* Returns the hypervolume of the set
+ *
+ * ARGS: set
+ * RTRN: the hypervolume */
+double dynhv_value(const dynhv_t *H);
+
+/* Returns the hypervolume a vector would add to the set if inserted, without inserting
+ * it, in O(log n) time plus O(log n) for every vector it dominates
+ *
+ * ARGS: set, vector (2 values)
+ * RTRN: the hypervolume gained */
+double dynhv_gain(const dynhv_t *H, const double *v);
+
+/* Returns the exclusive contribution of a vector of the set
+ *
+ * ARGS: set, vector (2 values)
+ * RTRN: its contribution, or -1 if it isn't in the set */
+double dynhv_contribution(const dynhv_t *H, const double *v);
+
+/* Returns the vector with the smallest exclusive contribution
+ *
+ * ARGS: set, output for the vector (2 values, or NULL)
+ * RTRN: its contribution, or -1 if the set is empty */
+double dynhv_min_contributor(const dynhv_t *H, double *v);
+
+#endif /* DYNHV_H_ */
@@ -0,0 +1,87 @@
+/*
+ * eaf.h
+ *
+ * Empirical attainment function of a collection of runs, summarized by its
+ * attainment surfaces
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EAF_H_
+#define EAF_H_
+
+#include "frontview.h"
+
+/* Attainment surfaces of a collection of runs (minimization of objectives). The k-th
+ * attainment surface bounds the region of the objective space weakly dominated by at
+ * least k of the runs, and is given by the minimal points of that region. */
+typedef struct
+{
+	int nruns;
+	int vlen;
+	int nlevels;
+	int *levels;        /* number of runs that attain each surface */
+	int *lens;          /* number of points of each surface */
+	double **surfaces;  /* points of each surface, as lens[l]*vlen row-major buffers,
+	                       sorted by the first objective (with three objectives, by
+	                       the third one and then by the first one) */
+}eaf_t;
+
+/* Converts a percentage of the runs into an attainment level: the k%-attainment surface
+ * is attained by at least ceil(k*nruns/100) runs (and at least one), so 50% gives the
+ * median attainment surface.
+ *
+ * ARGS: number of runs, percentage
+ * RTRN: the attainment level */
+int eaf_percent_level(int nruns, double percent);
+
+/* Computes the attainment surfaces of a collection of runs, with two or three
+ * objectives. With two objectives, all the points are sorted once and swept along the
+ * first objective, keeping the runs sorted by the best value of the second one they've
+ * reached, so the cost is O(n log n + n*nruns) for n points. With three, the points are
+ * swept along the third objective, and every point updates the two-objective surfaces
+ * of the points seen so far, up to the highest level asked for, only where it changes
+ * them; the points it adds to them are points of the three-objective surfaces, so the
+ * cost is O((n + m) log n), with m the number of points of those surfaces (including
+ * the lower levels, which the higher ones are built from). The runs don't need to be
+ * non-dominated.
+ * The returned structure must be freed with free_eaf.
+ *
+ * ARGS: array of views of the runs, number of runs, array of attainment levels to
+ *       compute (between 1 and nruns), or NULL for all of them, number of levels
+ * RTRN: the attainment surfaces, in the order of the levels */
+eaf_t *attainment_surfaces_view(const frontview_t *runs, int nruns, const int *levels,
+		int nlevels);
+
+/* Computes the attainment surfaces of a collection of runs
+ *
+ * ARGS: array of sets of vectors, array of set lengths, number of runs, vectors
+ *       length, array of attainment levels (or NULL for all), number of levels
+ * RTRN: the attainment surfaces */
+eaf_t *attainment_surfaces(double ***runs, const int *runlens, int nruns, int vlen,
+		const int *levels, int nlevels);
+
+/* Frees the memory used by a set of attainment surfaces
+ *
+ * ARGS: attainment surfaces */
+void free_eaf(eaf_t *E);
+
+#endif /* EAF_H_ */
@@ -25,13 +25,52 @@
 #ifndef EPSILON_H_
 #define EPSILON_H_
 
+#include <stddef.h>
+#include <float.h>
+
+#include "frontview.h"
+#include "reffront.h"
+
 typedef enum
 {
 	additive_e,
 	multiplicative_e
 }epsilon_t;
 
-/* Calculates the epsilon binary indicator from two sets of non-dominated vectors
+/* Epsilon value needed by vector a to weakly dominate vector b, i.e. the maximum over
+ * the objectives. Stops as soon as the value reaches cutoff, since callers only look
+ * for values below it.
+ *
+ * ARGS: vector a and the distance between its components, vector b and the distance
+ *       between its components, vectors length, method, cutoff (DBL_MAX for none)
+ * RTRN: the epsilon value, or some value not below cutoff */
+static inline double epsilon_pair(const double *a, ptrdiff_t as, const double *b,
+		ptrdiff_t bs, int vlen, epsilon_t method, double cutoff)
+{
+	int k;
+	double eps_k, eps_temp;
+
+	eps_k = -DBL_MAX;
+	for (k = 0; k < vlen; k++)
+	{
+		if (method == additive_e)
+			eps_temp = b[k*bs] - a[k*as];
+		else
+			eps_temp = b[k*bs] / a[k*as];
+		if (eps_k < eps_temp)
+		{
+			eps_k = eps_temp;
+			if (eps_k >= cutoff)
+				break;
+		}
+	}
+	return eps_k;
+}
+
+/* Calculates the epsilon binary indicator from two sets of non-dominated vectors. With
+ * the multiplicative method, every objective must have non-zero values of the same sign
+ * across both sets. If either set is empty, that isn't checked, and the result is 0 for
+ * an empty set B, or else DBL_MIN (additive) or 0 (multiplicative) for an empty set A.
  *
  * ARGS: set A, set A length, set B, set B length, vectors length (number of objectives),
  *       method: multiplicative or additive (see enum declaration on top)
@@ -42,4 +81,44 @@ double additive_epsilon(double **A, int Alen, double **B, int Blen, int vlen);
 
 double multiplicative_epsilon(double **A, int Alen, double **B, int Blen, int vlen);
 
+/* View version of epsilon. The vectors length is taken from the views, which may have
+ * different layouts (see frontview.h).
+ *
+ * ARGS: view of set A, view of set B, method: multiplicative or additive
+ * RTRN: the value of the calculated epsilon indicator  */
+double epsilon_view(const frontview_t *A, const frontview_t *B, epsilon_t method);
+
+/* Same as epsilon_view, using a guess of a vector of B close to each vector of A
+ * (typically the nearest one) to discard vectors of A that can't change the result
+ * without scanning B.
+ *
+ * ARGS: view of set A, view of set B, method: multiplicative or additive,
+ *       array with A's length of indices into B (-1 for no guess)
+ * RTRN: the value of the calculated epsilon indicator  */
+double epsilon_view_hint(const frontview_t *A, const frontview_t *B, epsilon_t method,
+		const int *nearest);
+
+/* Tells whether the multiplicative epsilon is defined for two sets: for every
+ * objective, all the values in both sets must be non-zero and share the same sign.
+ * The indicator functions end the process when they aren't; callers that can't afford
+ * that (such as servers) check first.
+ *
+ * ARGS: view of set A, view of set B
+ * RTRN: 1 if the sets are valid (or both empty), 0 otherwise */
+int epsilon_valid_multiplicative(const frontview_t *A, const frontview_t *B);
+
+/* Same as epsilon_valid_multiplicative, with a prepared set B, whose values are checked
+ * through its bounds
+ *
+ * ARGS: view of set A, prepared set B
+ * RTRN: 1 if the sets are valid (or both empty), 0 otherwise */
+int epsilon_valid_multiplicative_ref(const frontview_t *A, const reffront_t *B);
+
+/* Same as epsilon_view, with a prepared set B (see reffront.h), as when B is the true
+ * Pareto front
+ *
+ * ARGS: view of set A, prepared set B, method: multiplicative or additive
+ * RTRN: the value of the calculated epsilon indicator  */
+double epsilon_ref(const frontview_t *A, const reffront_t *B, epsilon_t method);
+
 #endif /* EPSILON_H_ */
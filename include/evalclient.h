@@ -0,0 +1,139 @@
+/*
+ * evalclient.h
+ *
+ * Protocol of the evaluation daemon (see evalserver.h) and client library
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EVALCLIENT_H_
+#define EVALCLIENT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "frontview.h"
+#include "suite.h"
+
+/* Protocol. Every request is an eval_request_hdr followed by namelen bytes of name
+ * and then by the payload: len*vlen doubles (row-major) for EVAL_OP_PUT and
+ * EVAL_OP_EVAL, namelen-less path bytes (len of them) for EVAL_OP_LOAD, nothing for
+ * EVAL_OP_DROP. Every request gets an eval_response, carrying the id of the request
+ * it answers; a connection may send several requests without waiting, and evaluation
+ * responses may come back in a different order. Both ends use the byte order of the
+ * machine, since the daemon only listens on a local socket. */
+#define EVAL_MAGIC      0x454f4f4du /* "MOOE" */
+#define EVAL_VERSION    1
+#define EVAL_NAME_MAX   255        /* maximum length of a front name */
+#define EVAL_MAX_VALUES (1 << 27)  /* maximum len*vlen of a payload */
+
+// Operations
+#define EVAL_OP_PUT     1 /* prepare the given front and keep it under the given name */
+#define EVAL_OP_LOAD    2 /* map a prepared front file (see reffront_save) under a name */
+#define EVAL_OP_DROP    3 /* forget a named front */
+#define EVAL_OP_EVAL    4 /* evaluate a set against a named front */
+
+/* Status codes, along with those of evaluations (EVAL_OK, EVAL_EVLEN and EVAL_EDATA,
+ * see suite.h) */
+#define EVAL_EPROTO     1 /* malformed request */
+#define EVAL_ENOFRONT   2 /* no front with that name */
+#define EVAL_EFILE      4 /* the front file couldn't be opened */
+#define EVAL_EIO        (-1) /* (client side) connection error */
+
+typedef struct
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t op;
+	uint32_t id;
+	uint32_t namelen;
+	uint32_t len;
+	uint32_t vlen;
+	uint32_t mask;     /* INDICATOR_* flags, for EVAL_OP_EVAL */
+	uint32_t reserved;
+}eval_request_hdr;
+
+typedef struct
+{
+	uint32_t id;
+	int32_t status;
+	indicator_results_t results; /* for EVAL_OP_EVAL */
+}eval_response;
+
+/* A connection to the daemon */
+typedef struct
+{
+	int fd;
+	uint32_t next_id;
+}eval_client_t;
+
+/* Connects to the daemon. The returned structure must be freed with eval_disconnect.
+ *
+ * ARGS: path of the daemon's socket
+ * RTRN: the connection, NULL (with errno set) if it couldn't be established */
+eval_client_t *eval_connect(const char *path);
+
+/* Sends a true front to the daemon, which prepares it and keeps it under the given
+ * name (replacing any other front with that name)
+ *
+ * ARGS: connection, name, view of the front
+ * RTRN: EVAL_OK or an error code */
+int eval_put_front(eval_client_t *C, const char *name, const frontview_t *front);
+
+/* Has the daemon map a prepared front file (see reffront_save) under the given name.
+ * The path is opened by the daemon, so it must be valid for it. Files that fail the
+ * checks of reffront_map are rejected with EVAL_EDATA.
+ *
+ * ARGS: connection, name, file path
+ * RTRN: EVAL_OK or an error code */
+int eval_load_front(eval_client_t *C, const char *name, const char *path);
+
+/* Has the daemon forget a front. Evaluations already queued against it still finish.
+ *
+ * ARGS: connection, name
+ * RTRN: EVAL_OK or an error code */
+int eval_drop_front(eval_client_t *C, const char *name);
+
+/* Evaluates a set of non-dominated vectors against a named front
+ * (see indicator_suite_view)
+ *
+ * ARGS: connection, name of the true front, view of the set, mask of INDICATOR_*
+ *       flags, output for the results
+ * RTRN: EVAL_OK or an error code */
+int eval_indicators(eval_client_t *C, const char *name, const frontview_t *front,
+		int mask, indicator_results_t *results);
+
+/* Closes a connection
+ *
+ * ARGS: connection */
+void eval_disconnect(eval_client_t *C);
+
+/* Reads or writes exactly size bytes, retrying on short transfers and interruptions.
+ * Shared by the client and the daemon.
+ *
+ * ARGS: file descriptor, buffer, size
+ * RTRN: 0 on success, -1 on error or end of file */
+int eval_read_all(int fd, void *buf, size_t size);
+
+int eval_write_all(int fd, const void *buf, size_t size);
+
+#endif /* EVALCLIENT_H_ */
@@ -0,0 +1,106 @@
+/*
+ * evalqueue.h
+ *
+ * Asynchronous evaluation of indicators by background threads
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALQUEUE_H_
+#define EVALQUEUE_H_
+
+#include "frontview.h"
+#include "reffront.h"
+#include "suite.h"
+
+/* Submission flags */
+#define EVAL_COPY    0x01 /* copy the set, so the caller can reuse it right away. Otherwise
+                             the set is borrowed: its data must stay untouched until the
+                             evaluation is done (see eval_ticket_poll). */
+#define EVAL_NOWAIT  0x02 /* if the queue is full, give up instead of waiting for room */
+
+/* A queue of evaluations, with a pool of threads taking them in order. The queue holds
+ * a bounded number of evaluations; submissions wait for room (or give up, with
+ * EVAL_NOWAIT) when it's full, so a producer can't pile up work and memory faster than
+ * the workers get through it. */
+typedef struct eval_queue eval_queue_t;
+
+/* Handle of a submitted evaluation */
+typedef struct eval_ticket eval_ticket_t;
+
+/* Function called by a worker when an evaluation is done, before its ticket is marked
+ * as done. It must not wait on tickets of the same queue.
+ *
+ * ARGS: ticket, status (EVAL_OK, EVAL_EVLEN or EVAL_EDATA, see suite.h), results
+ *       (valid only during the call), user argument given on submission */
+typedef void (*eval_callback_t)(eval_ticket_t *t, int status,
+		const indicator_results_t *results, void *arg);
+
+/* Starts a queue of evaluations
+ *
+ * ARGS: number of worker threads, maximum number of evaluations waiting in the queue
+ * RTRN: the queue */
+eval_queue_t *eval_queue_start(int nworkers, int capacity);
+
+/* Queues the evaluation of the indicators of a set against a prepared true front (see
+ * indicator_suite_ref). The true front is always borrowed, and must outlive the
+ * evaluation. The returned ticket must be released with eval_ticket_release, which may
+ * be done right away if only the callback is wanted.
+ *
+ * ARGS: queue, view of the set, prepared true front, mask of INDICATOR_* flags,
+ *       EVAL_* submission flags, completion callback (or NULL), its user argument
+ * RTRN: the ticket, NULL (with errno set to EAGAIN) if the queue was full and
+ *       EVAL_NOWAIT was given */
+eval_ticket_t *eval_queue_submit(eval_queue_t *Q, const frontview_t *front,
+		const reffront_t *truefront, int mask, int flags, eval_callback_t callback,
+		void *arg);
+
+/* Returns the number of evaluations waiting in the queue, not counting the ones being
+ * computed
+ *
+ * ARGS: queue
+ * RTRN: number of queued evaluations */
+int eval_queue_pending(eval_queue_t *Q);
+
+/* Stops a queue: waits for every queued evaluation to be done, and frees everything but
+ * the tickets not released yet
+ *
+ * ARGS: queue */
+void eval_queue_stop(eval_queue_t *Q);
+
+/* Checks whether an evaluation is done, in which case a borrowed set may be reused
+ *
+ * ARGS: ticket, output for the results (or NULL)
+ * RTRN: -1 if not done yet, or else the status (EVAL_OK, EVAL_EVLEN or EVAL_EDATA) */
+int eval_ticket_poll(eval_ticket_t *t, indicator_results_t *results);
+
+/* Waits for an evaluation to be done
+ *
+ * ARGS: ticket, output for the results (or NULL)
+ * RTRN: the status (EVAL_OK, EVAL_EVLEN or EVAL_EDATA) */
+int eval_ticket_wait(eval_ticket_t *t, indicator_results_t *results);
+
+/* Gives up a ticket. The evaluation still takes place if it isn't done yet.
+ *
+ * ARGS: ticket */
+void eval_ticket_release(eval_ticket_t *t);
+
+#endif /* EVALQUEUE_H_ */
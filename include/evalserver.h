@@ -0,0 +1,64 @@
+/*
+ * evalserver.h
+ *
+ * Local evaluation daemon keeping prepared true fronts in memory
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EVALSERVER_H_
+#define EVALSERVER_H_
+
+#include "reffront.h"
+
+/* Number of evaluations against the same front a worker takes from the queue at once */
+#define EVAL_BATCH 16
+
+/* An evaluation server. It listens on a Unix domain socket and speaks the protocol
+ * described in evalclient.h. Every connection gets a thread that reads its requests;
+ * fronts are prepared (or mapped) on arrival and kept by name, and evaluations are
+ * queued for a pool of workers. Each worker takes a batch of queued evaluations
+ * against the same front, so the front's data is reused while it's in cache. The queue
+ * holds a bounded number of evaluations: when it's full, reading threads wait for room
+ * before reading the next set, which holds back the clients that send them. */
+typedef struct eval_server eval_server_t;
+
+/* Starts a server on a new socket at the given path, which must not exist
+ *
+ * ARGS: socket path, number of worker threads, maximum number of evaluations waiting
+ *       in the queue
+ * RTRN: the server, NULL (with errno set) if the socket couldn't be set up */
+eval_server_t *eval_server_start(const char *path, int nworkers, int capacity);
+
+/* Keeps a prepared front under the given name, as EVAL_OP_PUT does. The server takes
+ * ownership of the front.
+ *
+ * ARGS: server, name, prepared front */
+void eval_server_put(eval_server_t *S, const char *name, reffront_t *R);
+
+/* Stops a server: closes every connection, waits for the queued evaluations, removes
+ * the socket and frees everything, fronts included.
+ *
+ * ARGS: server */
+void eval_server_stop(eval_server_t *S);
+
+#endif /* EVALSERVER_H_ */
@@ -0,0 +1,95 @@
+/*
+ * frontfile.h
+ *
+ * Binary front files, and double-buffered streaming of their vectors in chunks
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FRONTFILE_H_
+#define FRONTFILE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "frontview.h"
+
+/* Version of the front file format */
+#define FRONTFILE_VERSION 1
+
+/* Default number of vectors per chunk */
+#define FRONTSTREAM_CHUNK 65536
+
+/* A front file being read in chunks. A reader thread fills one buffer from disk while
+ * the other one is being processed, so reading overlaps with computation, and memory
+ * use is bounded by two chunks whatever the size of the file. */
+typedef struct
+{
+	int vlen;
+	int64_t len;
+	int has_bounds;        /* whether the file holds the bounds of the front */
+	double *min;           /* vlen minimum values (if has_bounds) */
+	double *max;           /* vlen maximum values (if has_bounds) */
+
+	// Reader state
+	FILE *file;
+	int chunklen;
+	int64_t remaining;     /* vectors not read from disk yet */
+	double *buf[2];
+	int count[2];          /* vectors in each buffer */
+	int full[2];           /* whether each buffer holds a chunk not yet processed */
+	int cur;               /* next buffer to be handed out */
+	int held;              /* buffer being processed, -1 if none */
+	int stop;
+	pthread_t reader;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+}frontstream_t;
+
+/* Saves a front to a binary file: a header with the number of vectors and their length,
+ * optionally followed by the bounds of the front (so they don't have to be computed
+ * when streaming it), followed by the vectors, row-major.
+ *
+ * ARGS: view of the front, file path, 1 to store the bounds */
+void frontfile_save(const frontview_t *front, const char *path, int with_bounds);
+
+/* Opens a front file for streaming, and starts reading its first chunk.
+ * The returned structure must be freed with frontstream_close.
+ *
+ * ARGS: file path, vectors per chunk (or 0 for FRONTSTREAM_CHUNK)
+ * RTRN: the stream */
+frontstream_t *frontstream_open(const char *path, int chunklen);
+
+/* Gets the next chunk of a stream. The chunk stays valid until the next call, when its
+ * buffer is handed back to the reader thread.
+ *
+ * ARGS: stream, output for a view of the chunk
+ * RTRN: number of vectors in the chunk, 0 at the end of the file */
+int frontstream_next(frontstream_t *S, frontview_t *chunk);
+
+/* Stops reading a stream (at any point) and frees it
+ *
+ * ARGS: stream */
+void frontstream_close(frontstream_t *S);
+
+#endif /* FRONTFILE_H_ */
@@ -0,0 +1,87 @@
+/*
+ * frontview.h
+ *
+ * Lightweight, non-owning views over sets of vectors stored in external buffers
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRONTVIEW_H_
+#define FRONTVIEW_H_
+
+#include <stddef.h>
+
+/* A view over a set of len vectors of vlen components each. The k-th component of the
+ * i-th vector lives at row_i[k*cstride], where row_i is rows[i] for views over jagged
+ * double** arrays, or base + i*rstride otherwise (rows == NULL). Strides are measured
+ * in doubles, so contiguous row-major buffers (C, NumPy) have rstride = vlen and
+ * cstride = 1, while column-major ones (Fortran, Eigen) have rstride = 1 and
+ * cstride = len. Views never own the memory they point to. */
+typedef struct
+{
+	double *base;
+	double **rows;
+	ptrdiff_t rstride;
+	ptrdiff_t cstride;
+	int len;
+	int vlen;
+}frontview_t;
+
+/* Creates a view over a jagged array, such as the ones returned by new_matrix_double
+ *
+ * ARGS: set of vectors, set length, vectors length
+ * RTRN: the view */
+frontview_t frontview_matrix(double **set, int setlen, int vlen);
+
+/* Creates a view over a contiguous row-major buffer
+ *
+ * ARGS: buffer, number of vectors, vectors length
+ * RTRN: the view */
+frontview_t frontview_rowmajor(double *data, int len, int vlen);
+
+/* Creates a view over a contiguous column-major buffer
+ *
+ * ARGS: buffer, number of vectors, vectors length
+ * RTRN: the view */
+frontview_t frontview_colmajor(double *data, int len, int vlen);
+
+/* Creates a view over an arbitrarily strided buffer
+ *
+ * ARGS: address of the first component of the first vector, number of vectors,
+ *       vectors length, stride between vectors, stride between components
+ * RTRN: the view */
+frontview_t frontview_strided(double *base, int len, int vlen,
+		ptrdiff_t rstride, ptrdiff_t cstride);
+
+/* Returns the address of the first component of the i-th vector of a view. Remaining
+ * components follow at intervals of cstride doubles. */
+static inline double *frontview_row(const frontview_t *v, int i)
+{
+	return v->rows ? v->rows[i] : v->base + i*v->rstride;
+}
+
+/* Returns the k-th component of the i-th vector of a view */
+static inline double frontview_at(const frontview_t *v, int i, int k)
+{
+	return frontview_row(v, i)[k*v->cstride];
+}
+
+#endif /* FRONTVIEW_H_ */
@@ -25,6 +25,10 @@
 #ifndef GAMMA_H_
 #define GAMMA_H_
 
+#include "frontview.h"
+#include "reffront.h"
+#include "qfront.h"
+
 /* Calculates the generational distance indicator for a set of non-dominated vectors
  *
  * ARGS: set of non-dominated vectors, set length, true pareto front, true front length,
@@ -41,4 +45,118 @@ double generational_distance(double **front, int frontlen,
 double inverted_generational_distance(double **front, int frontlen,
 		double **truefront, int truefrontlen, int vlen);
 
+/* View versions of the indicators above. The vectors length is taken from the views,
+ * which may have different layouts (see frontview.h).
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front */
+double generational_distance_view(const frontview_t *front, const frontview_t *truefront);
+
+double inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront);
+
+/* Same as the view versions, but normalizing with the given scale factors (see
+ * get_norm_scale) instead of computing them. Meant for evaluating several indicators
+ * against the same true front.
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front,
+ *       the true front's scale factors (or NULL to skip normalization) */
+double scaled_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale);
+
+double scaled_inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale);
+
+/* Dominance-aware (Pareto-compliant) versions of the indicators above, GD+ and IGD+,
+ * which measure the modified distance from every true front vector z to every vector a
+ * of the set: only the components where a is worse than z count, so a vector of the set
+ * that dominates part of the true front isn't penalized for it (see
+ * strided_plus_squared_dist). Distances are normalized and accumulated as in the plain
+ * indicators, so neither value is ever above its plain counterpart. Nearest vectors are
+ * searched through a pruned kd-tree (see nearest_plus_squared_dists).
+ *
+ * ARGS: set of non-dominated vectors, set length, true pareto front, true front length,
+ *       vector length (number of objectives).
+ * RTRN: the value of the indicator */
+double generational_distance_plus(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen);
+
+double inverted_generational_distance_plus(double **front, int frontlen,
+		double **truefront, int truefrontlen, int vlen);
+
+/* View versions of GD+ and IGD+
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front */
+double generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront);
+
+double inverted_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront);
+
+/* Same as the view versions of GD+ and IGD+, with the given scale factors
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front,
+ *       the true front's scale factors (or NULL to skip normalization) */
+double scaled_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale);
+
+double scaled_inverted_generational_distance_plus_view(const frontview_t *front,
+		const frontview_t *truefront, const double *scale);
+
+/* Same as the view versions, against a prepared true front (see reffront.h)
+ *
+ * ARGS: view of the set of non-dominated vectors, prepared true pareto front */
+double generational_distance_ref(const frontview_t *front, const reffront_t *truefront);
+
+double inverted_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront);
+
+/* Approximate versions of the generational distance indicators, for cheap monitoring.
+ * Nearest vectors are searched up to a relative tolerance (see kdtree_nearest_approx),
+ * so the value returned is never below the exact one nor above (1+eps) times it.
+ * The bound actually achieved, which is usually much tighter than eps, is also given:
+ * the exact value is at least the returned one divided by (1+bound). Many-objective
+ * sets are searched exactly, and their bound is 0.
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front (or
+ *       prepared true pareto front), relative tolerance, output for the achieved
+ *       bound (or NULL)
+ * RTRN: the approximate value of the indicator */
+double approx_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, double eps, double *bound);
+
+double approx_inverted_generational_distance_view(const frontview_t *front,
+		const frontview_t *truefront, double eps, double *bound);
+
+double approx_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront, double eps, double *bound);
+
+double approx_inverted_generational_distance_ref(const frontview_t *front,
+		const reffront_t *truefront, double eps, double *bound);
+
+/* Same as the view versions, against a quantized true front (see qfront.h), with the
+ * largest difference quantization can make in the result. Generational distance is
+ * searched directly on the quantized codes; for the inverted one, the true front is
+ * decoded a chunk at a time and searched through an index over the set.
+ *
+ * ARGS: view of the set of non-dominated vectors, quantized true pareto front, output
+ *       for the error bound (or NULL)
+ * RTRN: the value of the indicator */
+double generational_distance_quant(const frontview_t *front, const qfront_t *truefront,
+		double *bound);
+
+double inverted_generational_distance_quant(const frontview_t *front,
+		const qfront_t *truefront, double *bound);
+
+/* Calculates the inverted generational distance indicator of a set against a true
+ * front stored in a file written by frontfile_save, which is read in chunks (see
+ * frontfile.h), so memory use doesn't depend on the size of the true front. If the
+ * file doesn't hold the true front's bounds, it's read twice. The result is the same
+ * inverted_generational_distance_view gives for the whole true front.
+ *
+ * ARGS: view of the set of non-dominated vectors, path of the true front file,
+ *       vectors per chunk (or 0 for FRONTSTREAM_CHUNK)
+ * RTRN: the value of the inverted generational distance indicator  */
+double streaming_inverted_generational_distance(const frontview_t *front,
+		const char *truefront_path, int chunklen);
+
 #endif /* GAMMA_H_ */
@@ -0,0 +1,107 @@
+/*
+ * kdtree.h
+ *
+ * Kd-tree over a set of vectors, for nearest neighbour searches with few objectives
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KDTREE_H_
+#define KDTREE_H_
+
+#include <stddef.h>
+
+#include "frontview.h"
+
+/* Set length from which searches go through a kd-tree instead of a linear scan */
+#define KDTREE_MIN_LEN 64
+
+/* Node of a kd-tree. Leaves have no children (left is -1) and hold the vectors
+ * lo..hi-1 of the tree; inner nodes split theirs along component dim, the vectors of
+ * the left child being lower or equal than split, and the ones of the right child
+ * greater or equal. */
+typedef struct
+{
+	int lo, hi;
+	int left, right;
+	int dim;
+	double split;
+}kdnode_t;
+
+/* A kd-tree. The vectors are copied, as they are, into contiguous rows in the order of
+ * the leaves of the tree; the scale factors are applied to the differences. */
+typedef struct
+{
+	int len;
+	int vlen;
+	int nnodes;
+	double *pts;      /* len*vlen components, in tree order */
+	int *index;       /* index in the original set of each vector (NULL: tree order) */
+	double *scale;    /* copy of the scale factors, NULL if none */
+	kdnode_t *nodes;  /* node 0 is the root */
+}kdtree_t;
+
+/* Builds a kd-tree over a set of vectors. Every node is split at the median of the
+ * component along which its vectors are most spread out (after scaling).
+ * The returned structure must be freed with free_kdtree.
+ *
+ * ARGS: view of the set, scale factors to normalize the set with (or NULL)
+ * RTRN: the kd-tree */
+kdtree_t *kdtree_build(const frontview_t *set, const double *scale);
+
+/* Finds the nearest vector of a kd-tree to a query vector (given as is; the tree's
+ * scale factors are applied to the differences). Subtrees whose region is farther
+ * than the best distance found so far are skipped.
+ *
+ * ARGS: kd-tree, query vector and the distance between its components, 1 to ignore
+ *       vectors equal to the query, output for the index of the nearest vector in
+ *       the original set (or NULL)
+ * RTRN: the squared distance to the nearest vector, DBL_MAX if there is none */
+double kdtree_nearest(const kdtree_t *T, const double *x, ptrdiff_t xstride,
+		int distinct, int *nearest);
+
+/* Approximate version of kdtree_nearest: subtrees are also skipped when the vectors in
+ * them can't be nearer than the best distance found divided by (1+eps), so the distance
+ * returned is at most (1+eps) times the exact one. A lower bound of the exact squared
+ * distance is also returned, from which the error actually achieved can be told.
+ *
+ * ARGS: kd-tree, query vector and the distance between its components, relative
+ *       tolerance, output for the lower bound (or NULL), output for the index of the
+ *       vector found in the original set (or NULL)
+ * RTRN: the squared distance to the vector found, DBL_MAX if the tree is empty */
+double kdtree_nearest_approx(const kdtree_t *T, const double *x, ptrdiff_t xstride,
+		double eps, double *lower, int *nearest);
+
+/* Finds, for every vector of the set the kd-tree was built on, its nearest distinct
+ * vector in the same set. The vectors are processed leaf by leaf, and each search
+ * starts with the best distance found among the vectors of its own leaf.
+ *
+ * ARGS: kd-tree, output array for the squared distances (DBL_MAX if there is no
+ *       distinct vector), output array for the indices of the nearest vectors (or
+ *       NULL), both indexed as the original set */
+void kdtree_all_nearest(const kdtree_t *T, double *dists, int *nearest);
+
+/* Frees the memory used by a kd-tree
+ *
+ * ARGS: kd-tree */
+void free_kdtree(kdtree_t *T);
+
+#endif /* KDTREE_H_ */
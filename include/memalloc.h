@@ -22,6 +22,12 @@ float **new_matrix_float(size_t size_y, size_t size_x);
 
 double **new_matrix_double(size_t size_y, size_t size_x);
 
+/* Same as malloc and realloc, ending the process if there's no memory left. A size of 0
+ * still gives a pointer that can be freed (or reallocated). */
+void *checked_malloc(size_t size);
+
+void *checked_realloc(void *ptr, size_t size);
+
 void free_matrix(void **ptr, size_t size_y);
 
 void free_vector(void *ptr);
@@ -27,6 +27,9 @@
 #ifndef MOUTILS_H_
 #define MOUTILS_H_
 
+#include <stddef.h>
+
+#include "frontview.h"
 
 /* Filters out duplicate vectors from a set. newset must be freed upon use.
  *
@@ -35,6 +38,14 @@
 int remove_duplicates(double **set, int setlen, int vlen, double ***newset);
 
 
+/* Finds the unique vectors of a set, without copying them. The first vector of every
+ * group of equal vectors is kept.
+ *
+ * ARGS: view of the set, set-length output array for the indices of the unique vectors
+ * RTRN: number of unique vectors (indices written to unique) */
+int remove_duplicates_view(const frontview_t *set, int *unique);
+
+
 /* Determines if vector a dominates vector b (minimization of objectives)
  *
  * ARGS: vector a, vector b, number of objectives (length of vectors)
@@ -65,6 +76,34 @@ int domination_cmp(double *a, double *b, int vlen);
 int pareto_filter(double **set, int setlen, int vlen);
 
 
+/* Same as pareto_filter, but over a view. Since the vectors of a view can't be moved
+ * around, the resulting arrangement is returned as a permutation of their indices.
+ *
+ * ARGS: view of the set, set-length output array for the permutation
+ * RTRN: number of non-dominated vectors found, e.g. their indices are order[0..n-1] */
+int pareto_filter_view(const frontview_t *set, int *order);
+
+
+/* Same as remove_duplicates followed by pareto_filter, in O(n log n) time plus the
+ * dominance checks against the vectors kept (O(1) each for two objectives). The set is
+ * sorted once in lexicographical order, and equal and dominated vectors are dropped in
+ * a single scan. Only the row pointers are moved: the unique non-dominated vectors come
+ * first, in lexicographical order, followed by the duplicates and the dominated ones,
+ * so every row can still be freed.
+ *
+ * ARGS: set of vectors, set length, number of objectives (vector length)
+ * RTRN: number of unique non-dominated vectors, e.g. the index of the first vector left
+ *       out in set */
+int pareto_filter_unique(double **set, int setlen, int vlen);
+
+
+/* View version of pareto_filter_unique, returning the arrangement as a permutation
+ *
+ * ARGS: view of the set, set-length output array for the permutation
+ * RTRN: number of unique non-dominated vectors, e.g. their indices are order[0..n-1] */
+int pareto_filter_unique_view(const frontview_t *set, int *order);
+
+
 /* Returns the euclidian distance between two vectors
  *
  * ARGS: vector a, vector b, vectors length
@@ -95,6 +134,90 @@ double dist_closed_point(double *X, int vlen, double **front, int frontlen);
 double dist_nearest_point(double *X, int vlen, double **front, int frontlen);
 
 
+/* Check if two equal-sized strided vectors are equal (see frontview.h)
+ *
+ * ARGS: vector a, a's component stride, vector b, b's component stride, length of vectors
+ * RTRN: 1 if equal, 0 otherwise*/
+int strided_vectors_are_equal(const double *A, ptrdiff_t as,
+		const double *B, ptrdiff_t bs, int vlen);
+
+
+/* Returns the squared distance between two strided vectors (see frontview.h),
+ * normalized on the fly if scale is not NULL (see scaled_squared_dist)
+ *
+ * ARGS: vector a, a's component stride, vector b, b's component stride, vectors length,
+ *       scale factors (or NULL)
+ * RTRN: the squared euclidian distance between a and b */
+double strided_squared_dist(const double *A, ptrdiff_t as, const double *B, ptrdiff_t bs,
+		int vlen, const double *scale);
+
+
+/* Returns the squared modified distance of GD+ and IGD+ between two strided vectors,
+ * which only counts the components where b is greater (worse) than a, normalized on the
+ * fly if scale is not NULL. It is 0 when b is weakly dominated by a.
+ *
+ * ARGS: vector a, a's component stride, vector b, b's component stride, vectors length,
+ *       scale factors (or NULL)
+ * RTRN: the squared modified distance from a to b */
+double strided_plus_squared_dist(const double *A, ptrdiff_t as, const double *B,
+		ptrdiff_t bs, int vlen, const double *scale);
+
+
+/* Returns the squared distance between a strided vector and the nearest vector to it in
+ * a view, normalized on the fly if scale is not NULL. dist_closed_point and
+ * scaled_dist_closed_point are shorthands for this function.
+ *
+ * ARGS: vector X, X's component stride, view of the set, scale factors (or NULL)
+ * RTRN: the squared distance between X and the nearest point in the front */
+double view_dist_closed_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale);
+
+
+/* Same as view_dist_closed_point, ignoring the vectors equal to X
+ *
+ * ARGS: vector X, X's component stride, view of the set, scale factors (or NULL)
+ * RTRN: the squared distance between X and the nearest point in the front */
+double view_dist_nearest_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale);
+
+
+/* Same as view_dist_closed_point (or view_dist_nearest_point if distinct is set), but
+ * also tells which vector is the nearest one
+ *
+ * ARGS: vector X, X's component stride, view of the set, scale factors (or NULL),
+ *       1 to ignore vectors equal to X, output for the squared distance
+ * RTRN: index of the nearest vector in the front (-1 if there is none) */
+int view_closest_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale, int distinct, double *dist);
+
+
+/* Returns the squared distance between two vectors after normalizing them, without
+ * materializing the normalized vectors. Normalization offsets cancel out in a difference,
+ * so only the per-component scale factors (see get_norm_scale) are needed.
+ *
+ * ARGS: vector a, vector b, vectors length, vlen-sized array with the scale factors
+ * RTRN: the squared euclidian distance between the normalized a and b */
+double scaled_squared_dist(double *A, double *B, int vlen, double *scale);
+
+
+/* Same as dist_closed_point, but measuring distances between normalized vectors
+ * (see scaled_squared_dist)
+ *
+ * ARGS: vector X, vector length, set of vectors, set length, scale factors
+ * RTRN: the normalized squared distance between X and the nearest point in the front */
+double scaled_dist_closed_point(double *X, int vlen, double **front, int frontlen,
+		double *scale);
+
+
+/* Same as dist_nearest_point, but measuring distances between normalized vectors
+ * (see scaled_squared_dist)
+ *
+ * ARGS: vector X, vector length, set of vectors, set length, scale factors
+ * RTRN: the normalized squared distance between X and the nearest point in the front */
+double scaled_dist_nearest_point(double *X, int vlen, double **front, int frontlen,
+		double *scale);
+
+
 /**** NOTE *************************************************************************
  *  The following functions are used internally by the library and though it's
  *  perfectly possible to use them independently, I recommend against doing so.
@@ -121,6 +244,30 @@ double *get_min_values(double **front, int frontlen, int vlen);
 double *get_max_values(double **front, int frontlen, int vlen);
 
 
+/* Get both the minimum and the maximum values for each vector component of a given set
+ * of vectors in a single pass over the set.
+ *
+ * ARGS: set of vectors, set length, vector length, vlen-sized output array for the
+ *       minimum values, vlen-sized output array for the maximum values */
+void get_bounds(double **front, int frontlen, int vlen,
+		double *min_values, double *max_values);
+
+
+/* Get the normalization scale factors, 1/(max-min), for each vector component of a given
+ * set of vectors. Used for lazy normalization (see scaled_squared_dist) instead of
+ * normalize_front. The memory used by the returned array must be freed upon use.
+ *
+ * ARGS: set of vectors, set length, vector length
+ * RTRN: an array of size vlen with the scale factors for each vector component */
+double *get_norm_scale(double **front, int frontlen, int vlen);
+
+
+/* View versions of get_bounds and get_norm_scale */
+void view_bounds(const frontview_t *front, double *min_values, double *max_values);
+
+double *view_norm_scale(const frontview_t *front);
+
+
 /* Normalize a set of vectors using the minimum and maximum values for each vector
  * component. The memory used by the returned array must be freed upon use.
  *
@@ -139,6 +286,13 @@ double **normalize_front(double **front, int frontlen, int vlen,
 double **get_extreme_sols(double **front, int frontlen, int vlen);
 
 
+/* Get the indices of the extreme solutions of a given front, without copying them
+ *
+ * ARGS: view of the set, vlen-sized output array for the indices
+ *       (the i-th one holds the vector with the maximum i-th component) */
+void view_extreme_sols(const frontview_t *front, int *positions);
+
+
 /* Lexicographical comparision operator for two-dimensional vectors,
  * meant to be used by stdlib's qsort
  *
@@ -146,4 +300,11 @@ double **get_extreme_sols(double **front, int frontlen, int vlen);
  * RTRN: -1 if a < b, 1 if b > a, 0 otherwise */
 int lexicographical_compare(const void *_a, const void *_b);
 
+
+/* Sorts the vectors of a set in lexicographical order, for any vector length.
+ * The set is left untouched, and the ordering is returned as a permutation.
+ *
+ * ARGS: view of the set, set-length output array for the sorted indices */
+void lexicographical_order(const frontview_t *set, int *order);
+
 #endif /* COMMON_H_ */
@@ -0,0 +1,57 @@
+/*
+ * ndfilter.h
+ *
+ * Parallel non-dominated filter, for sets of many vectors and objectives
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDFILTER_H_
+#define NDFILTER_H_
+
+#include "frontview.h"
+
+/* Vectors per block below which a set isn't split any further */
+#define NDFILTER_MIN_BLOCK 1024
+
+/* Same as pareto_filter_view, across threads. The set is split into blocks (one per
+ * NDFILTER_MIN_BLOCK vectors, up to a few per thread), which are sorted by sum of
+ * objectives and filtered on their own, concurrently. The survivors of every block are
+ * then cross-checked against the survivors of the other blocks, which is enough to find
+ * every dominated vector; sorting by sum bounds the candidates that can dominate each
+ * of them. Blocks are handed out to the threads as they become idle. The non-dominated
+ * vectors (the same pareto_filter finds, duplicates included) come first in the
+ * permutation, followed by the dominated ones.
+ *
+ * ARGS: view of the set, set-length output array for the permutation, number of threads
+ *       (1 or less to use the calling one)
+ * RTRN: number of non-dominated vectors found, e.g. their indices are order[0..n-1] */
+int pareto_filter_parallel_view(const frontview_t *set, int *order, int nthreads);
+
+/* Same as pareto_filter, across threads (see pareto_filter_parallel_view)
+ *
+ * ARGS: set of vectors, set length, number of objectives (vector length), number of
+ *       threads
+ * RTRN: number of non-dominated vectors found, e.g. the index of the first dominated
+ *       vector in set */
+int pareto_filter_parallel(double **set, int setlen, int vlen, int nthreads);
+
+#endif /* NDFILTER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * nearest.h
+ *
+ * Nearest vector searches between sets, using the best engine for each case
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEAREST_H_
+#define NEAREST_H_
+
+#include "frontview.h"
+#include "biobj.h"
+#include "kdtree.h"
+
+/* Option flags for nearest_squared_dists */
+#define NEAREST_DISTINCT 0x1 /* ignore vectors equal to the query (as dist_nearest_point) */
+
+/* Computes, for every vector in X, the squared distance to the nearest vector in Y
+ * (as dist_closed_point, or dist_nearest_point with NEAREST_DISTINCT). Bi-objective
+ * sets are sorted and searched as staircases (see biobj.h), many-objective ones go
+ * through the blocked engine (see blockdist.h), and the rest are searched through a
+ * kd-tree (see kdtree.h), unless Y is too short for it to pay off.
+ * Queries with no valid candidate get DBL_MAX and index -1.
+ *
+ * ARGS: view of set X, view of set Y, scale factors (or NULL), option flags,
+ *       output array for the distances, output array for the indices of the nearest
+ *       vectors in Y (or NULL), both of X's length */
+void nearest_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int flags, double *dists, int *nearest);
+
+/* Computes, for every vector in X, the squared modified distance of GD+ and IGD+ (see
+ * strided_plus_squared_dist) to the nearest vector in Y. Y is searched through a
+ * kd-tree (see kdtree.h) whose nodes also keep their bounding boxes, since the splits
+ * alone only bound the modified distance on one side; subtrees whose box is farther
+ * than the best distance found are skipped, so the search stays exact. Short sets are
+ * scanned instead.
+ *
+ * ARGS: view of set X, view of set Y, scale factors (or NULL), side (greater than 0 to
+ *       count the components where Y's vectors are worse than X's, as in IGD+, lower
+ *       than 0 for the ones where they're better, as in GD+), output array for the
+ *       distances, of X's length */
+void nearest_plus_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int side, double *dists);
+
+/* Index over a set Y, built once to search the nearest vector of Y to the vectors of
+ * any number of sets (the search structure chosen depends on Y, as described for
+ * nearest_squared_dists). It refers to Y's data and to the scale factors, which must
+ * outlive it. */
+typedef struct
+{
+	frontview_t Y;
+	const double *scale;
+	staircase_t *S;     /* bi-objective sets */
+	kdtree_t *T;        /* 1 or 3 to 7 objectives, for long enough sets */
+}nearest_index_t;
+
+/* Builds an index over a set. The returned structure must be freed with
+ * free_nearest_index.
+ *
+ * ARGS: view of set Y, scale factors (or NULL)
+ * RTRN: the index */
+nearest_index_t *nearest_index_build(const frontview_t *Y, const double *scale);
+
+/* Same as nearest_squared_dists, through an index over Y
+ *
+ * ARGS: index over set Y, view of set X, option flags, output array for the distances,
+ *       output array for the indices of the nearest vectors in Y (or NULL) */
+void nearest_index_query(const nearest_index_t *I, const frontview_t *X, int flags,
+		double *dists, int *nearest);
+
+/* Approximate version of nearest_index_query: every distance found is at most (1+eps)
+ * times the exact one, and a lower bound of the exact squared distance is returned
+ * along with it. Sets searched by brute force (short or many-objective ones) get exact
+ * distances, equal to their bounds.
+ *
+ * ARGS: index over set Y, view of set X, relative tolerance, output array for the
+ *       squared distances, output array for their lower bounds, both of X's length */
+void nearest_index_query_approx(const nearest_index_t *I, const frontview_t *X,
+		double eps, double *dists, double *lower);
+
+/* Frees the memory used by an index
+ *
+ * ARGS: index */
+void free_nearest_index(nearest_index_t *I);
+
+/* Computes, for every vector in a set, the squared distance to its nearest distinct
+ * vector in the same set (what dist_nearest_point gives for each of them), in a single
+ * call. With 3 to 7 objectives, one kd-tree is built and traversed leaf by leaf.
+ * Vectors with no distinct neighbour get DBL_MAX and index -1.
+ *
+ * ARGS: set of vectors, set length, vectors length (number of objectives),
+ *       output array for the distances, output array for the indices of the nearest
+ *       vectors (or NULL), both of the set's length */
+void all_nearest_neighbours(double **set, int setlen, int vlen, double *dists,
+		int *nearest);
+
+/* View version of all_nearest_neighbours, with optional normalization
+ *
+ * ARGS: view of the set, scale factors (or NULL), output array for the distances,
+ *       output array for the indices of the nearest vectors (or NULL) */
+void all_nearest_neighbours_view(const frontview_t *set, const double *scale,
+		double *dists, int *nearest);
+
+#endif /* NEAREST_H_ */
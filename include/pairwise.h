@@ -0,0 +1,79 @@
+/*
+ * pairwise.h
+ *
+ * Binary indicators between every pair of a collection of sets, as needed for the
+ * statistical comparison of many runs
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAIRWISE_H_
+#define PAIRWISE_H_
+
+#include "frontview.h"
+#include "epsilon.h"
+
+/* Calculates the epsilon indicator between every pair of sets. Every set is copied
+ * once, sorted by its first objective, so the searches over it stop as soon as that
+ * objective alone rules out the vectors left. The pairs are spread over a number of
+ * threads. Entry i*nsets+j of the matrix is exactly what epsilon_view gives for sets
+ * i and j (in that order), diagonal included.
+ *
+ * ARGS: array of views of the sets, number of sets, method: multiplicative or
+ *       additive, number of threads (1 or less to use the calling one), nsets*nsets
+ *       output matrix, row-major */
+void epsilon_matrix_view(const frontview_t *sets, int nsets, epsilon_t method,
+		int nthreads, double *M);
+
+/* Calculates the epsilon indicator between every pair of sets
+ *
+ * ARGS: array of sets of vectors, array of set lengths, number of sets, vectors
+ *       length, method, number of threads, nsets*nsets output matrix, row-major */
+void epsilon_matrix(double ***sets, const int *setlens, int nsets, int vlen,
+		epsilon_t method, int nthreads, double *M);
+
+/* Calculates the set coverage indicator C(A, B) (Zitzler and Thiele): the fraction of
+ * the vectors of B weakly dominated by some vector of A (minimization of objectives).
+ * It's 0 when B is empty.
+ *
+ * ARGS: view of set A, view of set B
+ * RTRN: the value of the set coverage indicator */
+double set_coverage_view(const frontview_t *A, const frontview_t *B);
+
+double set_coverage(double **A, int Alen, double **B, int Blen, int vlen);
+
+/* Calculates the set coverage indicator between every pair of sets. Every set is
+ * sorted once and its bounding box is kept, so pairs of sets whose boxes don't overlap
+ * are settled right away, and so are the vectors outside the covering set's box.
+ * Entry i*nsets+j of the matrix is C(set i, set j).
+ *
+ * ARGS: array of views of the sets, number of sets, number of threads (1 or less to
+ *       use the calling one), nsets*nsets output matrix, row-major */
+void coverage_matrix_view(const frontview_t *sets, int nsets, int nthreads, double *M);
+
+/* Calculates the set coverage indicator between every pair of sets
+ *
+ * ARGS: array of sets of vectors, array of set lengths, number of sets, vectors
+ *       length, number of threads, nsets*nsets output matrix, row-major */
+void coverage_matrix(double ***sets, const int *setlens, int nsets, int vlen,
+		int nthreads, double *M);
+
+#endif /* PAIRWISE_H_ */
@@ -0,0 +1,96 @@
+/*
+ * qfront.h
+ *
+ * Compact reference fronts, with every objective quantized to 16 or 32 bits
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QFRONT_H_
+#define QFRONT_H_
+
+#include <stddef.h>
+
+#include "frontview.h"
+
+/* Vectors decoded at a time by qfront_decode's users */
+#define QFRONT_CHUNK 4096
+
+/* Vectors per block, each with its bounding box */
+#define QFRONT_BLOCK 64
+
+/* A reference (true) front quantized for storage: every value of objective k is kept
+ * as an unsigned integer code c, standing for min[k] + c*step[k], where the steps split
+ * the front's range of each objective into 2^bits - 1 intervals. A 16-bit front takes a
+ * quarter of the memory of a contiguous double one (and less than that of a jagged
+ * double** one). The vectors are stored in Z-order of their codes, and split into
+ * blocks of QFRONT_BLOCK, each with the bounding box of its codes. Normalization uses
+ * the scale factors of the original front. */
+typedef struct
+{
+	int len;
+	int vlen;
+	int bits;           /* 16 or 32 */
+	double *min;        /* vlen minimum values of the original front */
+	double *step;       /* vlen quantization steps */
+	double *scale;      /* vlen normalization factors of the original front (0 for
+	                       objectives with a single value) */
+	double *max_error;  /* vlen largest differences between a value and its quantized one */
+	double dist_error;  /* largest difference quantization makes in a normalized distance */
+	void *codes;        /* len*vlen codes, row-major, uint16_t or uint32_t */
+	int nblocks;
+	void *boxes;        /* nblocks*2*vlen codes: the lowest of every objective in each
+	                       block, followed by the highest */
+}qfront_t;
+
+/* Quantizes a reference front. The front is left untouched, and may be freed
+ * afterwards. The returned structure must be freed with free_qfront.
+ *
+ * ARGS: view of the reference front, bits per value (16 or 32)
+ * RTRN: the quantized front */
+qfront_t *qfront_build(const frontview_t *truefront, int bits);
+
+/* Returns the memory used by a quantized front
+ *
+ * ARGS: quantized front
+ * RTRN: size in bytes */
+size_t qfront_size(const qfront_t *Q);
+
+/* Decodes consecutive stored vectors into a contiguous row-major buffer
+ *
+ * ARGS: quantized front, first vector, number of vectors, output buffer (n*vlen) */
+void qfront_decode(const qfront_t *Q, int first, int n, double *out);
+
+/* Computes, for every vector in X, the squared normalized distance to the nearest
+ * vector of a quantized front, which is searched on its codes: the block with the
+ * nearest box is scanned first, and then the blocks whose boxes are nearer than the
+ * best distance found. Every distance differs from the one to the original front by at
+ * most Q->dist_error (before squaring).
+ *
+ * ARGS: quantized front, view of set X, output array for the distances (X's length) */
+void qfront_nearest_squared_dists(const qfront_t *Q, const frontview_t *X, double *dists);
+
+/* Frees the memory used by a quantized front
+ *
+ * ARGS: quantized front */
+void free_qfront(qfront_t *Q);
+
+#endif /* QFRONT_H_ */
@@ -0,0 +1,73 @@
+/*
+ * r2.h
+ *
+ * R2 indicator, with weighted Tchebycheff utilities
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef R2_H_
+#define R2_H_
+
+#include "frontview.h"
+
+/* Calculates the number of weight vectors of a simplex lattice, that is,
+ * (divisions + vlen - 1) choose (vlen - 1)
+ *
+ * ARGS: vectors length (number of objectives), number of divisions of each objective
+ * RTRN: the number of weight vectors */
+int simplex_lattice_size(int vlen, int divisions);
+
+/* Generates the uniform simplex-lattice weight vectors: all the vectors whose
+ * components are multiples of 1/divisions and add up to 1, in lexicographical order.
+ * The returned buffer must be freed with free_vector.
+ *
+ * ARGS: vectors length (number of objectives), number of divisions of each objective,
+ *       output for the number of weight vectors (or NULL)
+ * RTRN: the weight vectors, as a contiguous row-major buffer (see frontview_rowmajor) */
+double *simplex_lattice_weights(int vlen, int divisions, int *nweights);
+
+/* Calculates the R2 indicator of a set: the mean, over the weight vectors, of the
+ * smallest weighted Tchebycheff utility of the set's vectors,
+ *
+ *     R2 = 1/|W| * sum over w in W of (min over a of (max over k of w_k*|z_k - a_k|))
+ *
+ * where z is the ideal point (lower is better). The distances to the ideal point are
+ * computed once, stored objective by objective, and the utilities are reduced in blocks
+ * of weights against blocks of vectors that fit in cache, with a kernel compiled for
+ * several instruction sets (see cpudispatch.h). Blocks of weights are spread over a
+ * number of threads. The result doesn't depend on the number of threads.
+ *
+ * ARGS: view of the set, view of the weight vectors, ideal point (e.g. from
+ *       get_min_values), number of threads (1 or less to use the calling one)
+ * RTRN: the value of the R2 indicator */
+double r2_indicator_view(const frontview_t *front, const frontview_t *weights,
+		const double *ideal, int nthreads);
+
+/* Calculates the R2 indicator of a set, in the calling thread
+ *
+ * ARGS: set of vectors, set length, vectors length, weight vectors, number of weight
+ *       vectors, ideal point
+ * RTRN: the value of the R2 indicator */
+double r2_indicator(double **front, int frontlen, int vlen, double **weights,
+		int nweights, const double *ideal);
+
+#endif /* R2_H_ */
@@ -0,0 +1,77 @@
+/*
+ * reduce.h
+ *
+ * Reduction of reference fronts to well-spread subsets with a known covering radius
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef REDUCE_H_
+#define REDUCE_H_
+
+#include "frontview.h"
+
+/* Selects up to k representatives of a front by greedy farthest-point selection: each
+ * new representative is the vector farthest from the ones already selected. The
+ * selection starts with the vectors holding the minimum and maximum value of every
+ * objective, so the subset has the same bounds (and normalization) as the front.
+ * Selection stops early once every vector is within tol of a representative.
+ *
+ * The covering radius (the maximum distance from any vector of the front to its
+ * representative) is returned. It bounds how much the distance from any point to the
+ * front grows when the front is replaced by the subset, so the smallest subset meeting
+ * a tolerance on the distance-based indicators can be picked from it.
+ *
+ * ARGS: view of the front, scale factors to measure distances with (or NULL),
+ *       maximum number of representatives, tolerance (0 to select k representatives),
+ *       output array for the positions of the representatives (room for k), output
+ *       array with the front's length for the representative of every vector (or
+ *       NULL), output for the covering radius (or NULL)
+ * RTRN: the number of representatives selected */
+int reduce_farthest_point_view(const frontview_t *front, const double *scale, int k,
+		double tol, int *selected, int *assign, double *radius);
+
+/* Selects up to k representatives of a front with a grid coreset: the normalized
+ * objective space is split in cubic cells and the vector closest to the center of each
+ * non-empty cell is kept, along with the bound-defining vectors (see
+ * reduce_farthest_point_view). The cell size is the smallest one giving at most k
+ * representatives. Its cost doesn't depend on k, so it's cheaper than the farthest-
+ * point selection for large k, at the cost of a larger covering radius.
+ *
+ * ARGS: view of the front, scale factors (or NULL), maximum number of representatives,
+ *       output array for the positions of the representatives (room for k), output
+ *       array for the representative of every vector (or NULL), output for the
+ *       covering radius (or NULL)
+ * RTRN: the number of representatives selected */
+int reduce_grid_view(const frontview_t *front, const double *scale, int k,
+		int *selected, int *assign, double *radius);
+
+/* Farthest-point reduction of a front, normalized with its own bounds
+ *
+ * ARGS: set of vectors, set length, vectors length, maximum number of representatives,
+ *       output array for the indices of the representatives (room for k), output for
+ *       the covering radius (or NULL)
+ * RTRN: the number of representatives selected */
+int reduce_front(double **front, int frontlen, int vlen, int k, int *selected,
+		double *radius);
+
+#endif /* REDUCE_H_ */
@@ -0,0 +1,123 @@
+/*
+ * reffront.h
+ *
+ * Prepared reference fronts, which can be saved to a file and mapped back into memory
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef REFFRONT_H_
+#define REFFRONT_H_
+
+#include <stddef.h>
+
+#include "frontview.h"
+#include "biobj.h"
+#include "kdtree.h"
+
+/* Version of the reference front file format */
+#define REFFRONT_VERSION 1
+
+/* A reference (true) front, prepared once to be used by any number of indicator
+ * calls: its bounds and normalization factors, its lexicographical order, its extreme
+ * solutions and a nearest neighbour index are computed up front. The vectors are
+ * stored in the order the index needs them (sorted for bi-objective fronts, in kd-tree
+ * order for 3 to 7 objectives, as given otherwise), so every position in the fields
+ * below refers to view, and index maps them back to the original front.
+ *
+ * A prepared front saved with reffront_save and loaded with reffront_load is used as
+ * is from the mapped file, without rebuilding anything. */
+typedef struct
+{
+	int len;
+	int vlen;
+	frontview_t view;   /* the stored vectors, row-major */
+	double *min;        /* vlen minimum values */
+	double *max;        /* vlen maximum values */
+	double *scale;      /* vlen normalization factors (see view_norm_scale) */
+	int *index;         /* position in the original front of each stored vector */
+	int *order;         /* lexicographical order of the stored vectors */
+	int *extremes;      /* vlen extreme solutions (see view_extreme_sols) */
+	staircase_t stair;  /* nearest neighbour index of bi-objective fronts */
+	kdtree_t tree;      /* nearest neighbour index with 1 or 3 to 7 objectives */
+	void *map;          /* mapped file, NULL if prepared in memory */
+	size_t maplen;
+}reffront_t;
+
+/* Prepares a reference front. The front is copied, so it may be freed afterwards.
+ * The returned structure must be freed with free_reffront.
+ *
+ * ARGS: view of the reference front
+ * RTRN: the prepared front */
+reffront_t *reffront_prepare(const frontview_t *truefront);
+
+/* Saves a prepared reference front to a file, to be loaded with reffront_load on a
+ * machine with the same byte order and type sizes
+ *
+ * ARGS: prepared front, file path */
+void reffront_save(const reffront_t *R, const char *path);
+
+/* Maps a file written by reffront_save into memory. Nothing is copied or rebuilt;
+ * the stored positions and kd-tree nodes are only checked to be within bounds, so a
+ * corrupt file is rejected instead of being read outside the mapping.
+ * The returned structure must be freed with free_reffront.
+ *
+ * ARGS: file path
+ * RTRN: the prepared front */
+reffront_t *reffront_load(const char *path);
+
+/* Same as reffront_load, but reports errors to the caller instead of exiting. Files
+ * that aren't valid prepared fronts for this machine, or fail the bounds checks, set
+ * errno to EINVAL.
+ *
+ * ARGS: file path
+ * RTRN: the prepared front, NULL (with errno set) if it couldn't be loaded */
+reffront_t *reffront_map(const char *path);
+
+/* Computes, for every vector in X, the squared normalized distance to the nearest vector
+ * of a prepared reference front, through its index (see nearest_squared_dists)
+ *
+ * ARGS: prepared front, view of set X, option flags (NEAREST_*), output array for
+ *       the distances, output array for the positions of the nearest vectors in the
+ *       prepared front's view (or NULL), both of X's length */
+void reffront_nearest_squared_dists(const reffront_t *R, const frontview_t *X, int flags,
+		double *dists, int *nearest);
+
+/* Approximate version of reffront_nearest_squared_dists (see nearest_index_query_approx)
+ *
+ * ARGS: prepared front, view of set X, relative tolerance, output array for the squared
+ *       distances, output array for their lower bounds, both of X's length */
+void reffront_nearest_squared_dists_approx(const reffront_t *R, const frontview_t *X,
+		double eps, double *dists, double *lower);
+
+/* Reorders an array with one value per stored vector into the order of the original
+ * front, so values can be accumulated in the same order as with the original front
+ *
+ * ARGS: prepared front, input array, output array (both of the front's length) */
+void reffront_original_order(const reffront_t *R, const double *values, double *out);
+
+/* Frees the memory used by a prepared front, or unmaps it if it was loaded
+ *
+ * ARGS: prepared front */
+void free_reffront(reffront_t *R);
+
+#endif /* REFFRONT_H_ */
@@ -0,0 +1,117 @@
+/*
+ * rescache.h
+ *
+ * Content-addressed cache of indicator results, in memory or shared through a file
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESCACHE_H_
+#define RESCACHE_H_
+
+#include <stdint.h>
+
+#include "frontview.h"
+#include "reffront.h"
+#include "suite.h"
+
+/* Version of the cache file format */
+#define RESCACHE_VERSION 1
+
+/* Entries per set of the cache; a new entry replaces the least recently used one of
+ * its set */
+#define RESCACHE_WAYS 8
+
+/* A cache of indicator results, keyed by the contents of the set and of the true front
+ * (see front_hash) rather than by where they are stored, so the same evaluation is only
+ * computed once however many times its data is loaded. Entries are grouped in sets of
+ * RESCACHE_WAYS, picked by their key, and evicted in least recently used order within
+ * their set. Every entry remembers which indicators were requested, so a later request
+ * for others only computes the missing ones.
+ *
+ * A cache may live in memory or in a file, which is mapped and shared by every process
+ * that opens it: accesses are serialized with a lock on the file, so results computed
+ * by one process are found by the others. The file's size is fixed when it's created,
+ * and it's 64 bytes plus 96 bytes per entry. Caches may be used from several threads. */
+typedef struct rescache rescache_t;
+
+/* Hashes the contents of a set into 64 bits. Vectors are read in order, whatever the
+ * layout of the view, so equal sets stored in different ways get the same hash. The
+ * values are spread over 4 independent lanes, so their multiplications overlap, and
+ * the lanes are mixed at the end along with the set's dimensions.
+ *
+ * ARGS: view of the set
+ * RTRN: the hash */
+uint64_t front_hash(const frontview_t *set);
+
+/* Opens a cache. With a path, the file is created if it doesn't exist; an existing one
+ * keeps the number of entries it was created with. The returned structure must be
+ * freed with rescache_close.
+ *
+ * ARGS: path of the cache file (or NULL to keep the cache in memory), number of entries
+ *       (rounded up to a multiple of RESCACHE_WAYS)
+ * RTRN: the cache, NULL (with errno set) if the file couldn't be opened or created.
+ *       Files that aren't valid caches for this machine set errno to EINVAL */
+rescache_t *rescache_open(const char *path, int capacity);
+
+/* Returns the number of entries a cache holds at most
+ *
+ * ARGS: cache
+ * RTRN: number of entries */
+int rescache_capacity(const rescache_t *C);
+
+/* Same as indicator_suite_view, through a cache: the results stored for the same set
+ * and true front are returned if every requested indicator is among them, and
+ * otherwise only the missing ones are computed and added to the entry. Indicators are
+ * computed without holding the cache, so other threads and processes aren't kept
+ * waiting.
+ *
+ * ARGS: cache, view of the set of non-dominated vectors, view of the true pareto front,
+ *       mask of INDICATOR_* flags, output for the results
+ * RTRN: 1 if nothing had to be computed, 0 otherwise */
+int rescache_suite_view(rescache_t *C, const frontview_t *front,
+		const frontview_t *truefront, int mask, indicator_results_t *results);
+
+/* Same as rescache_suite_view, against a prepared true front (see indicator_suite_ref).
+ * The prepared front is keyed by its stored vectors, which are in a different order
+ * than the original front's, so their entries aren't shared.
+ *
+ * ARGS: cache, view of the set of non-dominated vectors, prepared true pareto front,
+ *       mask of INDICATOR_* flags, output for the results
+ * RTRN: 1 if nothing had to be computed, 0 otherwise */
+int rescache_suite_ref(rescache_t *C, const frontview_t *front,
+		const reffront_t *truefront, int mask, indicator_results_t *results);
+
+/* Same as indicator_suite, through a cache (see rescache_suite_view)
+ *
+ * ARGS: cache, set of non-dominated vectors, set length, true pareto front, true front
+ *       length, vectors length, mask of INDICATOR_* flags, output for the results
+ * RTRN: 1 if nothing had to be computed, 0 otherwise */
+int rescache_suite(rescache_t *C, double **front, int frontlen, double **truefront,
+		int truefrontlen, int vlen, int mask, indicator_results_t *results);
+
+/* Closes a cache, freeing its memory or unmapping its file. The file is kept, along
+ * with its entries.
+ *
+ * ARGS: cache */
+void rescache_close(rescache_t *C);
+
+#endif /* RESCACHE_H_ */
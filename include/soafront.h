@@ -0,0 +1,122 @@
+/*
+ * soafront.h
+ *
+ * Columnar (structure of arrays) fronts, with kernels that work across vectors
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOAFRONT_H_
+#define SOAFRONT_H_
+
+#include "frontview.h"
+#include "epsilon.h"
+
+/* Alignment of the columns, in bytes */
+#define SOAFRONT_ALIGN 64
+
+/* Columns are padded to a multiple of this many vectors */
+#define SOAFRONT_PAD 16
+
+/* A set of vectors stored column by column: component k of vector i is at
+ * data[k*stride + i]. Every column is aligned to SOAFRONT_ALIGN bytes and padded up to
+ * stride (a multiple of SOAFRONT_PAD) with copies of the last vector, so the kernels
+ * below go over whole vector registers of vectors, as many as each instruction set
+ * variant holds (2, 4 or 8), whatever the number of objectives. The padding never
+ * changes a result. */
+typedef struct
+{
+	int len;
+	int vlen;
+	int stride;     /* padded length of every column */
+	double *data;   /* vlen columns of stride values */
+}soafront_t;
+
+/* Returns the address of the k-th column of a columnar set */
+static inline double *soafront_column(const soafront_t *S, int k)
+{
+	return S->data + (size_t)k*S->stride;
+}
+
+/* Copies a set into a new columnar set, to be freed with free_soafront
+ *
+ * ARGS: view of the set
+ * RTRN: the columnar set */
+soafront_t *soafront_from_view(const frontview_t *set);
+
+/* Same as soafront_from_view, from a jagged array
+ *
+ * ARGS: set of vectors, set length, vectors length
+ * RTRN: the columnar set */
+soafront_t *soafront_from_matrix(double **set, int setlen, int vlen);
+
+/* Copies a columnar set into a new jagged array (see new_matrix_double), to be freed
+ * with free_matrix
+ *
+ * ARGS: columnar set
+ * RTRN: the set of vectors, with S->len rows of S->vlen values */
+double **soafront_to_matrix(const soafront_t *S);
+
+/* Returns a view over a columnar set (without its padding), so it can be given to any
+ * function that takes a view
+ *
+ * ARGS: columnar set
+ * RTRN: the view */
+frontview_t soafront_view(const soafront_t *S);
+
+/* Compares a vector with every vector of a columnar set according to Pareto dominance,
+ * as domination_cmp does
+ *
+ * ARGS: columnar set, vector (S->vlen values), output array of S->len values: -1 if
+ *       the vector dominates the set's, 1 if the set's dominates it, 0 otherwise
+ * RTRN: number of vectors of the set that dominate the vector */
+int soafront_dominance(const soafront_t *S, const double *x, signed char *out);
+
+/* Finds the nearest vector of a columnar set to every vector of a set, scanning all of
+ * them (as view_closest_point does, with the same results, ties going to the first
+ * one). Meant for sets too small, or with too many objectives, for the searches of
+ * nearest.h to pay off.
+ *
+ * ARGS: columnar set Y, view of set X, scale factors (or NULL), output array for the
+ *       squared distances, output array for the indices of the nearest vectors in Y
+ *       (or NULL), both of X's length */
+void soafront_nearest_squared_dists(const soafront_t *Y, const frontview_t *X,
+		const double *scale, double *dists, int *nearest);
+
+/* Same as view_bounds, for a columnar set
+ *
+ * ARGS: columnar set, vlen-sized output arrays for the minimum and maximum values */
+void soafront_bounds(const soafront_t *S, double *min_values, double *max_values);
+
+/* Same as epsilon_view, for columnar sets. For every vector of A, the vectors of B are
+ * scanned a block at a time, and the scan stops as soon as a block can't change the
+ * result.
+ *
+ * ARGS: columnar set A, columnar set B, method: multiplicative or additive
+ * RTRN: the value of the epsilon indicator */
+double soafront_epsilon(const soafront_t *A, const soafront_t *B, epsilon_t method);
+
+/* Frees the memory used by a columnar set
+ *
+ * ARGS: columnar set */
+void free_soafront(soafront_t *S);
+
+#endif /* SOAFRONT_H_ */
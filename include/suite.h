@@ -0,0 +1,99 @@
+/*
+ * suite.h
+ *
+ * Evaluation of several quality indicators at once, sharing the common work
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SUITE_H_
+#define SUITE_H_
+
+#include "frontview.h"
+#include "reffront.h"
+
+/* Indicator flags, to be combined into the mask passed to indicator_suite */
+#define INDICATOR_GD            0x01 /* generational distance */
+#define INDICATOR_IGD           0x02 /* inverted generational distance */
+#define INDICATOR_SPREAD        0x04 /* spread (two objectives only) */
+#define INDICATOR_GSPREAD       0x08 /* generalized spread */
+#define INDICATOR_GSPREAD_ORIG  0x10 /* generalized spread, as in Zhou's paper */
+#define INDICATOR_EPSILON_ADD   0x20 /* additive epsilon of the set against the true front */
+#define INDICATOR_EPSILON_MUL   0x40 /* multiplicative epsilon, likewise */
+#define INDICATOR_ALL           0x7f
+
+/* Status of an evaluation against a prepared true front, as returned by
+ * indicator_suite_check (the evaluation queue and the daemon's protocol share them) */
+#define EVAL_OK         0
+#define EVAL_EVLEN      3 /* vectors length doesn't match the front's */
+#define EVAL_EDATA      5 /* data not valid for the requested indicators, or a front
+                             file that isn't a valid prepared front */
+
+typedef struct
+{
+	int computed; /* mask of the indicators actually computed */
+	double gd;
+	double igd;
+	double spread;
+	double gspread;
+	double gspread_orig;
+	double epsilon_add;
+	double epsilon_mul;
+}indicator_results_t;
+
+/* Calculates the requested indicators for a set of non-dominated vectors against the
+ * true Pareto front. Normalization bounds are computed once, and the nearest vector of
+ * the true front to every vector of the set is searched once and shared by the
+ * generational distance and both epsilon indicators. Each value is the same the
+ * corresponding indicator function would return. Spread is skipped (and left out of
+ * results->computed) unless the sets are bi-objective.
+ *
+ * ARGS: set of non-dominated vectors, set length, true pareto front, true front length,
+ *       vectors length, mask of INDICATOR_* flags, output for the results */
+void indicator_suite(double **front, int frontlen, double **truefront, int truefrontlen,
+		int vlen, int mask, indicator_results_t *results);
+
+/* View version of indicator_suite
+ *
+ * ARGS: view of the set of non-dominated vectors, view of the true pareto front,
+ *       mask of INDICATOR_* flags, output for the results */
+void indicator_suite_view(const frontview_t *front, const frontview_t *truefront,
+		int mask, indicator_results_t *results);
+
+/* Same as indicator_suite_view, against a prepared true front (see reffront.h), so
+ * nothing about the true front is computed again
+ *
+ * ARGS: view of the set of non-dominated vectors, prepared true pareto front,
+ *       mask of INDICATOR_* flags, output for the results */
+void indicator_suite_ref(const frontview_t *front, const reffront_t *truefront, int mask,
+		indicator_results_t *results);
+
+/* Checks, without exiting, that the requested indicators can be calculated for a set
+ * against a prepared true front: the vectors lengths must match, the true front can't
+ * be empty, and the multiplicative epsilon needs the values it's defined for (see
+ * epsilon_valid_multiplicative).
+ *
+ * ARGS: view of the set, prepared true front, mask of INDICATOR_* flags
+ * RTRN: EVAL_OK, EVAL_EVLEN or EVAL_EDATA */
+int indicator_suite_check(const frontview_t *front, const reffront_t *truefront,
+		int mask);
+
+#endif /* SUITE_H_ */
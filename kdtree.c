@@ -0,0 +1,374 @@
+/*
+ * kdtree.c
+ *
+ * Kd-tree for nearest neighbour searches. The tree is stored as an array of nodes over
+ * a single copy of the set, reordered so that the vectors of every leaf are contiguous.
+ * Searches keep, for the region being visited, the offset of the query along every
+ * splitting component crossed so far, so the distance from the query to the region is
+ * updated incrementally and whole subtrees are skipped with a single comparison.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "kdtree.h"
+
+// Maximum number of vectors in a leaf
+#define KD_LEAF 8
+
+/* The distance to a region is accumulated in a different order than the distance to
+ * a vector, so it may be rounded slightly up. Regions are only skipped when they are
+ * clearly farther than the best vector found. */
+#define KD_SLACK (1 - 1e-12)
+
+// Queries with up to this many components keep their offsets on the stack
+#define KD_STACK_VLEN 16
+
+static inline double scale_of(const kdtree_t *T, int k)
+{
+	return T->scale ? T->scale[k] : 1;
+}
+
+/* Rearranges perm[lo..hi-1] (and keys along with it) so that keys[k] is the one
+ * that would be there if the range were sorted, with lower or equal keys on its left
+ * and greater or equal ones on its right */
+static void select_kth(int *perm, double *keys, int lo, int hi, int k)
+{
+	int i, j, t;
+	double pivot, tk;
+
+	while (hi - lo > 1)
+	{
+		pivot = keys[lo + (hi - lo)/2];
+		i = lo;
+		j = hi - 1;
+		while (i <= j)
+		{
+			while (keys[i] < pivot)
+				i++;
+			while (keys[j] > pivot)
+				j--;
+			if (i <= j)
+			{
+				tk = keys[i]; keys[i] = keys[j]; keys[j] = tk;
+				t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+				i++;
+				j--;
+			}
+		}
+		if (k <= j)
+			hi = j + 1;
+		else if (k >= i)
+			lo = i;
+		else
+			break;
+	}
+}
+
+static int build_node(kdtree_t *T, const frontview_t *set, int *perm, double *keys,
+		int lo, int hi)
+{
+	int node, i, k, dim, mid;
+	double v, min, max, spread, best;
+
+	node = T->nnodes++;
+	T->nodes[node].lo = lo;
+	T->nodes[node].hi = hi;
+	T->nodes[node].left = -1;
+	T->nodes[node].right = -1;
+	T->nodes[node].dim = 0;
+	T->nodes[node].split = 0;
+	if (hi - lo <= KD_LEAF)
+		return node;
+
+	// Split along the component with the widest (scaled) range
+	dim = 0;
+	best = 0;
+	for (k = 0; k < T->vlen; k++)
+	{
+		min = DBL_MAX;
+		max = -DBL_MAX;
+		for (i = lo; i < hi; i++)
+		{
+			v = frontview_at(set, perm[i], k);
+			if (v < min)
+				min = v;
+			if (v > max)
+				max = v;
+		}
+		spread = (max - min) * scale_of(T, k);
+		if (spread > best)
+		{
+			best = spread;
+			dim = k;
+		}
+	}
+	// All the vectors are equal
+	if (best == 0)
+		return node;
+
+	for (i = lo; i < hi; i++)
+		keys[i] = frontview_at(set, perm[i], dim);
+	mid = lo + (hi - lo)/2;
+	select_kth(perm, keys, lo, hi, mid);
+
+	T->nodes[node].dim = dim;
+	T->nodes[node].split = keys[mid];
+	T->nodes[node].left = build_node(T, set, perm, keys, lo, mid);
+	T->nodes[node].right = build_node(T, set, perm, keys, mid, hi);
+	return node;
+}
+
+kdtree_t *kdtree_build(const frontview_t *set, const double *scale)
+{
+	int i, k;
+	int *perm;
+	double *keys;
+	kdtree_t *T;
+
+	T = malloc(sizeof(kdtree_t));
+	if (T)
+		T->nodes = malloc(sizeof(kdnode_t)*((size_t)set->len/2 + 2));
+	if (!T || !T->nodes)
+	{
+		perror("MOOUtils: Out of memory when building kd-tree");
+		exit(EXIT_FAILURE);
+	}
+	T->len = set->len;
+	T->vlen = set->vlen;
+	T->nnodes = 0;
+	T->scale = NULL;
+	if (scale)
+	{
+		T->scale = new_vector_double(set->vlen);
+		memcpy(T->scale, scale, sizeof(double)*set->vlen);
+	}
+
+	/* Leaves hold at least KD_LEAF/2 vectors (unless the whole set fits in one), so
+	 * there are at most len/4 leaves and len/2 nodes */
+	perm = new_vector_int(set->len + 1);
+	keys = new_vector_double(set->len + 1);
+	for (i = 0; i < set->len; i++)
+		perm[i] = i;
+	if (set->len > 0)
+		build_node(T, set, perm, keys, 0, set->len);
+
+	T->pts = new_vector_double((size_t)set->len*set->vlen + 1);
+	T->index = perm;
+	for (i = 0; i < set->len; i++)
+		for (k = 0; k < set->vlen; k++)
+			T->pts[(size_t)i*set->vlen + k] = frontview_at(set, perm[i], k);
+
+	free_vector(keys);
+	return T;
+}
+
+/* State of a search */
+typedef struct
+{
+	const double *x;     /* query vector and the distance between its components */
+	ptrdiff_t xs;
+	int distinct;
+	double shrink;       /* regions are skipped when farther than shrink*bestd */
+	double pruned;       /* squared distance to the nearest region skipped */
+	double *off;         /* offsets of the query from the current region */
+	double bestd;
+	int best;
+}kd_query;
+
+/* Searches the subtree of a node. rd is the squared distance from the query to the
+ * node's region, made up of the offsets in Q->off. */
+static void search_node(const kdtree_t *T, int node, kd_query *Q, double rd)
+{
+	int i, dim, near, far;
+	double d, diff, old;
+	const double *p;
+	const kdnode_t *N = &T->nodes[node];
+
+	if (N->left < 0)
+	{
+		for (i = N->lo; i < N->hi; i++)
+		{
+			p = T->pts + (size_t)i*T->vlen;
+			if (Q->distinct && strided_vectors_are_equal(Q->x, Q->xs, p, 1, T->vlen))
+				continue;
+			d = strided_squared_dist(Q->x, Q->xs, p, 1, T->vlen, T->scale);
+			if (d < Q->bestd)
+			{
+				Q->bestd = d;
+				Q->best = i;
+			}
+		}
+		return;
+	}
+
+	dim = N->dim;
+	diff = (Q->x[dim*Q->xs] - N->split) * scale_of(T, dim);
+	if (diff <= 0)
+	{
+		near = N->left;
+		far = N->right;
+	}
+	else
+	{
+		near = N->right;
+		far = N->left;
+	}
+	search_node(T, near, Q, rd);
+
+	old = Q->off[dim];
+	rd = rd - old*old + diff*diff;
+	if (rd*KD_SLACK < Q->bestd*Q->shrink)
+	{
+		Q->off[dim] = diff;
+		search_node(T, far, Q, rd);
+		Q->off[dim] = old;
+	}
+	else if (rd*KD_SLACK < Q->pruned)
+	{
+		Q->pruned = rd*KD_SLACK;
+	}
+}
+
+/* Runs a search from the root, with the offsets on the stack when they fit */
+static void search_tree(const kdtree_t *T, kd_query *Q)
+{
+	int k;
+	double stack_off[KD_STACK_VLEN];
+
+	Q->bestd = DBL_MAX;
+	Q->best = -1;
+	Q->pruned = DBL_MAX;
+	if (T->len == 0)
+		return;
+	Q->off = (T->vlen <= KD_STACK_VLEN) ? stack_off : new_vector_double(T->vlen);
+	for (k = 0; k < T->vlen; k++)
+		Q->off[k] = 0;
+	search_node(T, 0, Q, 0);
+	if (Q->off != stack_off)
+		free_vector(Q->off);
+}
+
+double kdtree_nearest(const kdtree_t *T, const double *x, ptrdiff_t xstride,
+		int distinct, int *nearest)
+{
+	kd_query Q;
+
+	Q.x = x;
+	Q.xs = xstride;
+	Q.distinct = distinct;
+	Q.shrink = 1;
+	search_tree(T, &Q);
+	if (nearest)
+		*nearest = (Q.best < 0) ? -1 : (T->index ? T->index[Q.best] : Q.best);
+	return Q.bestd;
+}
+
+double kdtree_nearest_approx(const kdtree_t *T, const double *x, ptrdiff_t xstride,
+		double eps, double *lower, int *nearest)
+{
+	kd_query Q;
+
+	Q.x = x;
+	Q.xs = xstride;
+	Q.distinct = 0;
+	Q.shrink = 1 / ((1 + eps)*(1 + eps));
+	search_tree(T, &Q);
+	if (nearest)
+		*nearest = (Q.best < 0) ? -1 : (T->index ? T->index[Q.best] : Q.best);
+	if (lower)
+		*lower = (Q.pruned < Q.bestd) ? Q.pruned : Q.bestd;
+	return Q.bestd;
+}
+
+void kdtree_all_nearest(const kdtree_t *T, double *dists, int *nearest)
+{
+	int n, i, j;
+	double d;
+	const double *p;
+	const kdnode_t *N;
+	kd_query Q;
+
+	// Offsets are restored on the way back, so they're zeroed only once
+	Q.off = new_vector_double(T->vlen + 1);
+	Q.xs = 1;
+	Q.distinct = 1;
+	Q.shrink = 1;
+	for (n = 0; n < T->nnodes; n++)
+	{
+		N = &T->nodes[n];
+		if (N->left >= 0)
+			continue;
+		for (i = N->lo; i < N->hi; i++)
+		{
+			Q.x = T->pts + (size_t)i*T->vlen;
+			Q.bestd = DBL_MAX;
+			Q.best = -1;
+			Q.pruned = DBL_MAX;
+			// The vectors of the same leaf are likely to be close
+			for (j = N->lo; j < N->hi; j++)
+			{
+				p = T->pts + (size_t)j*T->vlen;
+				if (j == i || strided_vectors_are_equal(Q.x, 1, p, 1, T->vlen))
+					continue;
+				d = strided_squared_dist(Q.x, 1, p, 1, T->vlen, T->scale);
+				if (d < Q.bestd)
+				{
+					Q.bestd = d;
+					Q.best = j;
+				}
+			}
+			search_node(T, 0, &Q, 0);
+			if (T->index)
+			{
+				dists[T->index[i]] = Q.bestd;
+				if (nearest)
+					nearest[T->index[i]] = (Q.best >= 0) ? T->index[Q.best] : -1;
+			}
+			else
+			{
+				dists[i] = Q.bestd;
+				if (nearest)
+					nearest[i] = Q.best;
+			}
+		}
+	}
+	free_vector(Q.off);
+}
+
+void free_kdtree(kdtree_t *T)
+{
+	if (!T)
+		return;
+	free_vector(T->pts);
+	if (T->index)
+		free_vector(T->index);
+	if (T->scale)
+		free_vector(T->scale);
+	free(T->nodes);
+	free(T);
+}
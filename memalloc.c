@@ -108,6 +108,28 @@ double **new_matrix_double(size_t size_y, size_t size_x)
 	return retP;
 }
 
+void *checked_malloc(size_t size)
+{
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr)
+	{
+		perror("MOOUtils: Out of memory");
+		exit(EXIT_FAILURE);
+	}
+	return ptr;
+}
+
+void *checked_realloc(void *ptr, size_t size)
+{
+	ptr = realloc(ptr, size ? size : 1);
+	if (!ptr)
+	{
+		perror("MOOUtils: Out of memory");
+		exit(EXIT_FAILURE);
+	}
+	return ptr;
+}
+
 void free_matrix(void **ptr, size_t size_y)
 {
 	size_t i;
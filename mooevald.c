@@ -0,0 +1,104 @@
+/*
+ * mooevald.c
+ *
+ * Evaluation daemon. Keeps prepared true fronts in memory and evaluates the sets sent
+ * to it through a Unix domain socket (see evalserver.h and evalclient.h).
+ *
+ * Usage: mooevald [-w workers] [-q queue] socket [name=prepared_front_file ...]
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "reffront.h"
+#include "evalserver.h"
+
+int main (int argc, char *argv[])
+{
+	int opt, sig, i, nworkers, capacity, nfronts;
+	char *sep, **names;
+	sigset_t sigs;
+	reffront_t **fronts;
+	eval_server_t *S;
+
+	nworkers = sysconf(_SC_NPROCESSORS_ONLN);
+	capacity = 0;
+	while ((opt = getopt(argc, argv, "w:q:")) != -1)
+	{
+		if (opt == 'w')
+		{
+			nworkers = atoi(optarg);
+		}
+		else if (opt == 'q')
+		{
+			capacity = atoi(optarg);
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-w workers] [-q queue] socket [name=file ...]\n", argv[0]);
+			return (EXIT_FAILURE);
+		}
+	}
+	if (optind >= argc)
+	{
+		fprintf(stderr, "Usage: %s [-w workers] [-q queue] socket [name=file ...]\n", argv[0]);
+		return (EXIT_FAILURE);
+	}
+
+	/* Preload the given fronts before creating the socket, as a bad file ends the
+	 * process and would leave it behind */
+	names = malloc(sizeof(char*)*argc);
+	fronts = malloc(sizeof(reffront_t*)*argc);
+	if (!names || !fronts)
+	{
+		perror("MOOUtils: Out of memory");
+		return (EXIT_FAILURE);
+	}
+	for (nfronts = 0, i = optind + 1; i < argc; i++)
+	{
+		sep = strchr(argv[i], '=');
+		if (!sep)
+		{
+			fprintf(stderr, "Ignoring %s (expected name=file)\n", argv[i]);
+			continue;
+		}
+		*sep = '\0';
+		names[nfronts] = argv[i];
+		fronts[nfronts++] = reffront_load(sep + 1);
+	}
+
+	// Termination signals are taken synchronously, so every thread must block them
+	sigemptyset(&sigs);
+	sigaddset(&sigs, SIGINT);
+	sigaddset(&sigs, SIGTERM);
+	sigaddset(&sigs, SIGHUP);
+	pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+	// By default, enough evaluations for a few whole batches per worker
+	if (capacity <= 0)
+		capacity = 4*EVAL_BATCH*(nworkers > 0 ? nworkers : 1);
+	S = eval_server_start(argv[optind], nworkers, capacity);
+	if (!S)
+	{
+		perror("MOOUtils: Error creating socket");
+		return (EXIT_FAILURE);
+	}
+
+	for (i = 0; i < nfronts; i++)
+		eval_server_put(S, names[i], fronts[i]);
+	free(names);
+	free(fronts);
+
+	fprintf(stderr, "Listening on %s with %d workers\n", argv[optind], nworkers);
+	sigwait(&sigs, &sig);
+	eval_server_stop(S);
+
+	return (EXIT_SUCCESS);
+}
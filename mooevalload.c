@@ -0,0 +1,220 @@
+/*
+ * mooevalload.c
+ *
+ * Load test for the evaluation daemon. Sends a true front to it, then has several
+ * threads, each with its own connection, evaluate the same set over and over, and
+ * reports the throughput and the latencies.
+ *
+ * Usage: mooevalload [-t threads] [-n requests per thread] [-m mask] socket
+ *                    truefront_file set_file
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "frontview.h"
+#include "suite.h"
+#include "evalclient.h"
+
+#define FRONT_NAME "mooevalload"
+
+typedef struct
+{
+	const char *path;
+	const frontview_t *set;
+	int mask;
+	int requests;
+	double *latencies;
+	int failures;
+	indicator_results_t results;
+}worker_args;
+
+double *read_front(const char *file, int *len, int *vlen);
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static int double_compare(const void *a, const void *b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+static void *worker(void *arg)
+{
+	worker_args *w = arg;
+	int i;
+	double t;
+	eval_client_t *C;
+
+	C = eval_connect(w->path);
+	if (!C)
+	{
+		perror("Error connecting");
+		w->failures = w->requests;
+		return NULL;
+	}
+	for (i = 0; i < w->requests; i++)
+	{
+		t = now();
+		if (eval_indicators(C, FRONT_NAME, w->set, w->mask, &w->results) != EVAL_OK)
+			w->failures++;
+		w->latencies[i] = now() - t;
+	}
+	eval_disconnect(C);
+	return NULL;
+}
+
+int main (int argc, char *argv[])
+{
+	int opt, i, j, nthreads, requests, mask, total, failures, status;
+	int tflen, tfvlen, setlen, setvlen;
+	double *tfdata, *setdata, *latencies, start, elapsed, mean;
+	frontview_t tf, set;
+	eval_client_t *C;
+	worker_args *args;
+	pthread_t *threads;
+
+	nthreads = 4;
+	requests = 100;
+	mask = INDICATOR_GD | INDICATOR_IGD | INDICATOR_EPSILON_ADD;
+	while ((opt = getopt(argc, argv, "t:n:m:")) != -1)
+	{
+		if (opt == 't')
+			nthreads = atoi(optarg);
+		else if (opt == 'n')
+			requests = atoi(optarg);
+		else if (opt == 'm')
+			mask = strtol(optarg, NULL, 0);
+		else
+			break;
+	}
+	if (argc - optind != 3 || nthreads <= 0 || requests <= 0)
+	{
+		fprintf(stderr, "Usage: %s [-t threads] [-n requests] [-m mask] socket "
+				"truefront_file set_file\n", argv[0]);
+		return (EXIT_FAILURE);
+	}
+
+	tfdata = read_front(argv[optind + 1], &tflen, &tfvlen);
+	setdata = read_front(argv[optind + 2], &setlen, &setvlen);
+	if (!tfdata || !setdata || tfvlen != setvlen)
+	{
+		fprintf(stderr, "Error reading the fronts\n");
+		return (EXIT_FAILURE);
+	}
+	tf = frontview_rowmajor(tfdata, tflen, tfvlen);
+	set = frontview_rowmajor(setdata, setlen, setvlen);
+
+	C = eval_connect(argv[optind]);
+	if (!C)
+	{
+		perror("Error connecting");
+		return (EXIT_FAILURE);
+	}
+	status = eval_put_front(C, FRONT_NAME, &tf);
+	if (status != EVAL_OK)
+	{
+		fprintf(stderr, "Error sending the true front (%d)\n", status);
+		return (EXIT_FAILURE);
+	}
+
+	args = calloc(nthreads, sizeof(worker_args));
+	threads = calloc(nthreads, sizeof(pthread_t));
+	latencies = calloc((size_t)nthreads*requests, sizeof(double));
+	start = now();
+	for (i = 0; i < nthreads; i++)
+	{
+		args[i].path = argv[optind];
+		args[i].set = &set;
+		args[i].mask = mask;
+		args[i].requests = requests;
+		args[i].latencies = latencies + (size_t)i*requests;
+		pthread_create(&threads[i], NULL, &worker, &args[i]);
+	}
+	failures = 0;
+	for (i = 0; i < nthreads; i++)
+	{
+		pthread_join(threads[i], NULL);
+		failures += args[i].failures;
+	}
+	elapsed = now() - start;
+	eval_drop_front(C, FRONT_NAME);
+	eval_disconnect(C);
+
+	total = nthreads*requests;
+	mean = 0;
+	for (j = 0; j < total; j++)
+		mean += latencies[j];
+	mean /= total;
+	qsort(latencies, total, sizeof(double), &double_compare);
+
+	printf("Requests: %d (%d failed) in %.3f s, %.1f req/s\n", total, failures, elapsed,
+			total/elapsed);
+	printf("Latency (ms): mean %.3f, p50 %.3f, p99 %.3f, max %.3f\n", mean*1e3,
+			latencies[total/2]*1e3, latencies[(int)(total*0.99)]*1e3,
+			latencies[total-1]*1e3);
+	printf("Last results: GD %.6f, IGD %.6f, epsilon+ %.6f\n", args[0].results.gd,
+			args[0].results.igd, args[0].results.epsilon_add);
+
+	free(args);
+	free(threads);
+	free(latencies);
+	free(tfdata);
+	free(setdata);
+	return (failures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/* Reads a front from a text file, one vector per line, into a row-major buffer.
+ * The vectors length is the number of values in the first line. */
+double *read_front(const char *file, int *len, int *vlen)
+{
+	FILE *input;
+	char line[4096], *p, *end;
+	double *data, v;
+	size_t count, cap;
+
+	input = fopen(file, "r");
+	if (!input)
+		return NULL;
+	*vlen = 0;
+	count = 0;
+	cap = 1024;
+	data = malloc(sizeof(double)*cap);
+	while (fgets(line, sizeof(line), input))
+	{
+		for (p = line; ; p = end)
+		{
+			v = strtod(p, &end);
+			if (end == p)
+				break;
+			if (count == cap)
+			{
+				cap *= 2;
+				data = realloc(data, sizeof(double)*cap);
+			}
+			data[count++] = v;
+		}
+		if (*vlen == 0)
+			*vlen = count;
+	}
+	fclose(input);
+	if (*vlen == 0 || count % *vlen)
+	{
+		free(data);
+		return NULL;
+	}
+	*len = count / *vlen;
+	return data;
+}
@@ -24,54 +24,79 @@
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include <stddef.h>
 
 #include "memalloc.h"
+#include "frontview.h"
 #include "moutils.h"
+#include "cpudispatch.h"
 
-void swap_points(double **a, double **b)
+static inline int strided_dominates(const double *a, ptrdiff_t as,
+		const double *b, ptrdiff_t bs, int vlen)
 {
-	double *tmp = *a;
-	*a = *b;
-	*b = tmp;
+	int i, better_in_any;
+
+	better_in_any = 0;
+	for (i = 0; i < vlen && a[i*as] <= b[i*bs]; i++)
+		if (a[i*as] < b[i*bs])
+			better_in_any = 1;
+
+	return ((i >= vlen) && better_in_any);
 }
 
-int remove_duplicates(double **set, int setlen, int vlen, double ***newset)
+int strided_vectors_are_equal(const double *A, ptrdiff_t as,
+		const double *B, ptrdiff_t bs, int vlen)
 {
-	size_t i, j;
-	int unique[setlen];
+	int i;
+	for (i = 0; i < vlen; i++)
+	{
+		if (A[i*as] != B[i*bs])
+			return 0;
+	}
+	return 1;
+}
 
-	for (i = 0; i < setlen; i++)
-		unique[i] = 1;
+int remove_duplicates_view(const frontview_t *set, int *unique)
+{
+	int i, j, ctr;
+	const double *row;
+	char dup[set->len > 0 ? set->len : 1];
+
+	for (i = 0; i < set->len; i++)
+		dup[i] = 0;
 
-	for (i = 0; i < (setlen-1); i++)
+	ctr = 0;
+	for (i = 0; i < set->len; i++)
 	{
-		for (j = i; j < setlen; j++)
+		if (dup[i])
+			continue;
+		unique[ctr++] = i;
+		row = frontview_row(set, i);
+		for (j = i + 1; j < set->len; j++)
 		{
-			if ((i != j) && (unique[i] || unique[j]))
-			{
-				if (vectors_are_equal(set[i], set[j], vlen))
-					unique[j] = 0;
-			}
+			if (!dup[j] && strided_vectors_are_equal(row, set->cstride,
+					frontview_row(set, j), set->cstride, set->vlen))
+				dup[j] = 1;
 		}
 	}
+	return ctr;
+}
 
-	int ctr = 0;
-	for (i = 0; i < setlen; i++)
-	{
-		if (unique[i])
-			ctr++;
-	}
+int remove_duplicates(double **set, int setlen, int vlen, double ***newset)
+{
+	size_t i, j;
+	int ctr;
+	int *unique = new_vector_int(setlen > 0 ? setlen : 1);
+	frontview_t view = frontview_matrix(set, setlen, vlen);
+
+	ctr = remove_duplicates_view(&view, unique);
 	(*newset) = new_matrix_double(ctr, vlen);
-	ctr = 0;
-	for (i = 0; i < setlen; i++)
+	for (i = 0; i < ctr; i++)
 	{
-		if (unique[i])
-		{
-			for (j = 0; j < vlen; j++)
-				(*newset)[ctr][j] = set[i][j];
-			ctr++;
-		}
+		for (j = 0; j < vlen; j++)
+			(*newset)[i][j] = set[unique[i]][j];
 	}
+	free_vector(unique);
 	return ctr;
 }
 
@@ -96,29 +121,42 @@ int domination_cmp(double *a, double *b, int vlen)
 	return 0;
 }
 
-int pareto_filter(double **set, int setlen, int vlen)
+static inline void swap_indices(int *a, int *b)
 {
-    int  i, j, n;
+	int tmp = *a;
+	*a = *b;
+	*b = tmp;
+}
 
-	n = setlen;
+int pareto_filter_view(const frontview_t *set, int *order)
+{
+	int i, j, n;
+	ptrdiff_t cs = set->cstride;
+
+	for (i = 0; i < set->len; i++)
+		order[i] = i;
+
+	n = set->len;
 	i = 0;
 	while (i < n)
 	{
 		j = i + 1;
 		while (j < n)
 		{
-			if (dominates(set[i], set[j], vlen))
+			if (strided_dominates(frontview_row(set, order[i]), cs,
+					frontview_row(set, order[j]), cs, set->vlen))
 			{
 				/* remove vector 'j' */
 				n--;
-				swap_points(&set[j], &set[n]);
+				swap_indices(&order[j], &order[n]);
 			}
-			else if (dominates(set[j], set[i], vlen))
+			else if (strided_dominates(frontview_row(set, order[j]), cs,
+					frontview_row(set, order[i]), cs, set->vlen))
 			{
 				/* remove vector 'i'; ensure that the vector copied to index 'i'
 				 is considered in the next outer loop (thus, decrement i) */
 				n--;
-				swap_points(&set[j], &set[n]);
+				swap_indices(&order[i], &order[n]);
 				i--;
 				break;
 			}
@@ -130,6 +168,96 @@ int pareto_filter(double **set, int setlen, int vlen)
 	return n;
 }
 
+int pareto_filter(double **set, int setlen, int vlen)
+{
+	int i, n;
+	int *order;
+	double **rows;
+	frontview_t view;
+
+	if (setlen <= 0)
+		return 0;
+	order = new_vector_int(setlen);
+	rows = malloc(sizeof(double*)*setlen);
+	view = frontview_matrix(set, setlen, vlen);
+
+	// Filter on indices, then apply the resulting order to the row pointers
+	n = pareto_filter_view(&view, order);
+	for (i = 0; i < setlen; i++)
+		rows[i] = set[order[i]];
+	for (i = 0; i < setlen; i++)
+		set[i] = rows[i];
+
+	free(rows);
+	free_vector(order);
+	return n;
+}
+
+int pareto_filter_unique_view(const frontview_t *set, int *order)
+{
+	int i, j, n, last, keep;
+	int *sorted;
+	const double *row;
+	ptrdiff_t cs = set->cstride;
+
+	if (set->len <= 0)
+		return 0;
+	sorted = new_vector_int(set->len);
+	lexicographical_order(set, sorted);
+
+	/* A vector can only be dominated by vectors before it in lexicographical order, and
+	 * equal vectors end up next to each other, so one scan does it: every vector is
+	 * checked against its predecessor and the unique non-dominated vectors found so
+	 * far, which stay non-dominated. Bi-objective survivors form a staircase, so only
+	 * the last one needs checking. */
+	n = 0;
+	last = set->len;
+	for (i = 0; i < set->len; i++)
+	{
+		row = frontview_row(set, sorted[i]);
+		keep = (i == 0 || !strided_vectors_are_equal(frontview_row(set, sorted[i-1]), cs,
+				row, cs, set->vlen));
+		for (j = n - 1; j >= 0 && keep; j--)
+		{
+			if (strided_dominates(frontview_row(set, order[j]), cs, row, cs, set->vlen))
+				keep = 0;
+			if (set->vlen == 2)
+				break;
+		}
+		if (keep)
+			order[n++] = sorted[i];
+		else
+			order[--last] = sorted[i];
+	}
+	free_vector(sorted);
+	return n;
+}
+
+int pareto_filter_unique(double **set, int setlen, int vlen)
+{
+	int i, n;
+	int *order;
+	double **rows;
+	frontview_t view;
+
+	if (setlen <= 0)
+		return 0;
+	order = new_vector_int(setlen);
+	rows = malloc(sizeof(double*)*setlen);
+	view = frontview_matrix(set, setlen, vlen);
+
+	// Same as pareto_filter: only the row pointers are moved
+	n = pareto_filter_unique_view(&view, order);
+	for (i = 0; i < setlen; i++)
+		rows[i] = set[order[i]];
+	for (i = 0; i < setlen; i++)
+		set[i] = rows[i];
+
+	free(rows);
+	free_vector(order);
+	return n;
+}
+
 int vectors_are_equal(double *A, double *B, int vlen)
 {
 	int i;
@@ -159,36 +287,147 @@ double squared_dist(double *A, double *B, int vlen)
 	return sum;
 }
 
-double dist_closed_point(double *X, int vlen, double **front, int frontlen)
+double strided_squared_dist(const double *A, ptrdiff_t as, const double *B, ptrdiff_t bs,
+		int vlen, const double *scale)
 {
 	int i;
-	double dist, mindist;
-	mindist = DBL_MAX;
-	for (i = 0; i < frontlen; i++)
+	double diff, sum;
+	sum = 0;
+	if (scale)
 	{
-		dist = squared_dist(X, front[i], vlen);
-		if (dist < mindist)
-			mindist = dist;
+		for (i = 0; i < vlen; i++)
+		{
+			diff = (A[i*as] - B[i*bs]) * scale[i];
+			sum += diff * diff;
+		}
 	}
-	return mindist;
+	else
+	{
+		for (i = 0; i < vlen; i++)
+		{
+			diff = A[i*as] - B[i*bs];
+			sum += diff * diff;
+		}
+	}
+	return sum;
 }
 
-double dist_nearest_point(double *X, int vlen, double **front, int frontlen)
+double strided_plus_squared_dist(const double *A, ptrdiff_t as, const double *B,
+		ptrdiff_t bs, int vlen, const double *scale)
 {
 	int i;
+	double diff, sum;
+	sum = 0;
+	for (i = 0; i < vlen; i++)
+	{
+		diff = B[i*bs] - A[i*as];
+		if (diff > 0)
+		{
+			if (scale)
+				diff *= scale[i];
+			sum += diff * diff;
+		}
+	}
+	return sum;
+}
+
+/* Shared body of view_dist_closed_point, view_dist_nearest_point and view_closest_point.
+ * Contiguous vectors (the common case) get their own loop, where the strides are known
+ * to be 1. */
+static inline double view_min_dist(const double *X, ptrdiff_t xs, const frontview_t *front,
+		const double *scale, int distinct, int *nearest)
+{
+	int i, best;
+	const double *row;
 	double dist, mindist;
+	ptrdiff_t fs = front->cstride;
+
 	mindist = DBL_MAX;
-	for (i = 0; i < frontlen; i++)
+	best = -1;
+	if (xs == 1 && fs == 1)
 	{
-		if (!vectors_are_equal(X, front[i], vlen))
+		for (i = 0; i < front->len; i++)
 		{
-			dist = squared_dist(X, front[i], vlen);
+			row = frontview_row(front, i);
+			if (distinct && strided_vectors_are_equal(X, 1, row, 1, front->vlen))
+				continue;
+			dist = strided_squared_dist(X, 1, row, 1, front->vlen, scale);
 			if (dist < mindist)
+			{
 				mindist = dist;
+				best = i;
+			}
 		}
 	}
+	else
+	{
+		for (i = 0; i < front->len; i++)
+		{
+			row = frontview_row(front, i);
+			if (distinct && strided_vectors_are_equal(X, xs, row, fs, front->vlen))
+				continue;
+			dist = strided_squared_dist(X, xs, row, fs, front->vlen, scale);
+			if (dist < mindist)
+			{
+				mindist = dist;
+				best = i;
+			}
+		}
+	}
+	if (nearest)
+		*nearest = best;
 	return mindist;
+}
+
+double view_dist_closed_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale)
+{
+	return view_min_dist(X, xstride, front, scale, 0, NULL);
+}
+
+double view_dist_nearest_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale)
+{
+	return view_min_dist(X, xstride, front, scale, 1, NULL);
+}
+
+int view_closest_point(const double *X, ptrdiff_t xstride, const frontview_t *front,
+		const double *scale, int distinct, double *dist)
+{
+	int nearest;
+	*dist = view_min_dist(X, xstride, front, scale, distinct, &nearest);
+	return nearest;
+}
+
+double dist_closed_point(double *X, int vlen, double **front, int frontlen)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	return view_dist_closed_point(X, 1, &view, NULL);
+}
+
+double dist_nearest_point(double *X, int vlen, double **front, int frontlen)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	return view_dist_nearest_point(X, 1, &view, NULL);
+}
 
+double scaled_squared_dist(double *A, double *B, int vlen, double *scale)
+{
+	return strided_squared_dist(A, 1, B, 1, vlen, scale);
+}
+
+double scaled_dist_closed_point(double *X, int vlen, double **front, int frontlen,
+		double *scale)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	return view_dist_closed_point(X, 1, &view, scale);
+}
+
+double scaled_dist_nearest_point(double *X, int vlen, double **front, int frontlen,
+		double *scale)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	return view_dist_nearest_point(X, 1, &view, scale);
 }
 
 double *get_min_values(double **front, int frontlen, int vlen)
@@ -215,7 +454,7 @@ double *get_max_values(double **front, int frontlen, int vlen)
 	size_t i, j;
 	double *max_values = malloc(sizeof(double)*vlen);
 	for (i = 0; i < vlen; i++)
-		max_values[i] = 0;
+		max_values[i] = -DBL_MAX;
 	for (i = 0; i < frontlen; i++)
 	{
 		for (j = 0; j < vlen; j++)
@@ -229,6 +468,117 @@ double *get_max_values(double **front, int frontlen, int vlen)
 	return max_values;
 }
 
+/* Shared body of the variants of view_bounds. The running bounds are kept in local
+ * arrays, which the compiler knows don't overlap the set, so the loop over the
+ * components of contiguous vectors is vectorized. */
+static inline __attribute__((always_inline)) void bounds_body(const frontview_t *front,
+		double *min_values, double *max_values)
+{
+	int i, j, vlen = front->vlen;
+	double v, lo[vlen], hi[vlen];
+	const double *row;
+	ptrdiff_t cs = front->cstride;
+
+	for (j = 0; j < vlen; j++)
+	{
+		lo[j] = DBL_MAX;
+		hi[j] = -DBL_MAX;
+	}
+	if (cs == 1)
+	{
+		for (i = 0; i < front->len; i++)
+		{
+			row = frontview_row(front, i);
+			for (j = 0; j < vlen; j++)
+			{
+				v = row[j];
+				lo[j] = (v < lo[j]) ? v : lo[j];
+				hi[j] = (v > hi[j]) ? v : hi[j];
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < front->len; i++)
+		{
+			row = frontview_row(front, i);
+			for (j = 0; j < vlen; j++)
+			{
+				v = row[j*cs];
+				lo[j] = (v < lo[j]) ? v : lo[j];
+				hi[j] = (v > hi[j]) ? v : hi[j];
+			}
+		}
+	}
+	for (j = 0; j < vlen; j++)
+	{
+		min_values[j] = lo[j];
+		max_values[j] = hi[j];
+	}
+}
+
+static void bounds_generic(const frontview_t *front, double *min_values,
+		double *max_values)
+{
+	bounds_body(front, min_values, max_values);
+}
+
+#if MOO_ISA_VARIANTS
+static MOO_TARGET_AVX2 void bounds_avx2(const frontview_t *front, double *min_values,
+		double *max_values)
+{
+	bounds_body(front, min_values, max_values);
+}
+
+static MOO_TARGET_AVX512 void bounds_avx512(const frontview_t *front,
+		double *min_values, double *max_values)
+{
+	bounds_body(front, min_values, max_values);
+}
+#endif
+
+void view_bounds(const frontview_t *front, double *min_values, double *max_values)
+{
+#if MOO_ISA_VARIANTS
+	switch (moo_active_isa())
+	{
+		case moo_isa_avx512:
+			bounds_avx512(front, min_values, max_values);
+			return;
+		case moo_isa_avx2:
+			bounds_avx2(front, min_values, max_values);
+			return;
+		default:
+			break;
+	}
+#endif
+	bounds_generic(front, min_values, max_values);
+}
+
+void get_bounds(double **front, int frontlen, int vlen,
+		double *min_values, double *max_values)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	view_bounds(&view, min_values, max_values);
+}
+
+double *view_norm_scale(const frontview_t *front)
+{
+	int j;
+	double min_values[front->vlen];
+	double *scale = malloc(sizeof(double)*front->vlen);
+	view_bounds(front, min_values, scale);
+	for (j = 0; j < front->vlen; j++)
+		scale[j] = 1.0 / (scale[j] - min_values[j]);
+	return scale;
+}
+
+double *get_norm_scale(double **front, int frontlen, int vlen)
+{
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+	return view_norm_scale(&view);
+}
+
 double **normalize_front(double **front, int frontlen, int vlen,
 		double *min_values, double *max_values)
 {
@@ -245,21 +595,23 @@ double **normalize_front(double **front, int frontlen, int vlen,
 	return (normalized_front);
 }
 
-double **get_extreme_sols(double **front, int frontlen, int vlen)
+void view_extreme_sols(const frontview_t *front, int *positions)
 {
-	size_t i, j;
-	double max_fit[vlen], cur_fit;
-	double **extreme_sols = new_matrix_double(vlen, vlen);
-	int positions[vlen];
-	for (i = 0; i < vlen; i++)
+	int i, j;
+	double max_fit[front->vlen], cur_fit;
+	const double *row;
+
+	for (i = 0; i < front->vlen; i++)
 	{
-		max_fit[i] = 0;
+		max_fit[i] = -DBL_MAX;
+		positions[i] = 0;
 	}
-	for (i = 0; i < frontlen; i++)
+	for (i = 0; i < front->len; i++)
 	{
-		for (j = 0; j < vlen; j++)
+		row = frontview_row(front, i);
+		for (j = 0; j < front->vlen; j++)
 		{
-			cur_fit = front[i][j];
+			cur_fit = row[j*front->cstride];
 			if (cur_fit > max_fit[j])
 			{
 				max_fit[j] = cur_fit;
@@ -267,6 +619,16 @@ double **get_extreme_sols(double **front, int frontlen, int vlen)
 			}
 		}
 	}
+}
+
+double **get_extreme_sols(double **front, int frontlen, int vlen)
+{
+	size_t i, j;
+	int positions[vlen];
+	double **extreme_sols = new_matrix_double(vlen, vlen);
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+
+	view_extreme_sols(&view, positions);
 	for (i = 0; i < vlen; i++)
 	{
 		for (j = 0; j < vlen; j++)
@@ -277,6 +639,66 @@ double **get_extreme_sols(double **front, int frontlen, int vlen)
 	return (extreme_sols);
 }
 
+/* Lexicographical comparison of two vectors of a view */
+static inline int view_lex_cmp(const frontview_t *set, int a, int b)
+{
+	int k;
+	double va, vb;
+	const double *ra = frontview_row(set, a);
+	const double *rb = frontview_row(set, b);
+
+	for (k = 0; k < set->vlen; k++)
+	{
+		va = ra[k*set->cstride];
+		vb = rb[k*set->cstride];
+		if (va < vb)
+			return -1;
+		if (va > vb)
+			return 1;
+	}
+	return 0;
+}
+
+void lexicographical_order(const frontview_t *set, int *order)
+{
+	int width, lo, mid, hi, i, j, k;
+	int *src, *dst, *tmp;
+	int *buffer = new_vector_int(set->len > 0 ? set->len : 1);
+
+	/* Bottom-up merge sort. Unlike qsort, it needs no global state to know the vectors
+	 * length, and it's stable. */
+	for (i = 0; i < set->len; i++)
+		order[i] = i;
+	src = order;
+	dst = buffer;
+	for (width = 1; width < set->len; width *= 2)
+	{
+		for (lo = 0; lo < set->len; lo += 2*width)
+		{
+			mid = (lo + width < set->len) ? lo + width : set->len;
+			hi = (lo + 2*width < set->len) ? lo + 2*width : set->len;
+			i = lo;
+			j = mid;
+			k = lo;
+			while (i < mid && j < hi)
+				dst[k++] = (view_lex_cmp(set, src[j], src[i]) < 0) ? src[j++] : src[i++];
+			while (i < mid)
+				dst[k++] = src[i++];
+			while (j < hi)
+				dst[k++] = src[j++];
+		}
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	if (src != order)
+	{
+		for (i = 0; i < set->len; i++)
+			order[i] = src[i];
+	}
+	free_vector(buffer);
+}
+
 //This ordering is only used in Spread, wich is exclusive for bi-objective problems
 static int _vlen = 2;
 int lexicographical_compare(const void *_a, const void *_b)
@@ -0,0 +1,336 @@
+/*
+ * ndfilter.c
+ *
+ * Parallel non-dominated filter, by divide and conquer. The set is split into blocks,
+ * which are sorted and filtered on their own, and the survivors of every block are then
+ * cross-checked against the survivors of all the others. A vector that dominates
+ * another one has a smaller or equal sum of objectives (rounding is monotonic), so
+ * sorting by sum means a vector can only be dominated by vectors before it in its own
+ * block, and by a prefix of the survivors of every other block. Vectors with small sums
+ * are also the likeliest to dominate others, so they're tested first. Dominance tests
+ * stop at the first objective that rules dominance out.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "ndfilter.h"
+
+// Blocks per thread, so that idle threads have something left to take
+#define NDFILTER_BLOCKS_PER_THREAD 4
+
+typedef struct nd_job nd_job;
+typedef void (*nd_task)(nd_job *J, int task);
+
+/* State shared by the threads. Every stage is a number of independent tasks, taken in
+ * order from a shared counter. */
+struct nd_job
+{
+	const frontview_t *set;
+	int len;
+	int vlen;
+	int nblocks;
+	int *bounds;         /* first position of every block, and len at the end */
+	double *sums;        /* sum of the objectives of every vector */
+	int *order;          /* vectors of every block, sorted */
+	int *tmp;            /* merge buffer */
+	double *P;           /* the vectors, in sorted order, row-major */
+	double *psums;       /* their sums */
+	int *surv;           /* survivors of every block, as positions from bounds[b] on */
+	int *nsurv;
+	char *alive;
+
+	nd_task task;
+	int ntasks;
+	int next;
+	pthread_mutex_t lock;
+};
+
+/* Compares two vectors by sum of objectives, and then lexicographically */
+static inline int sum_lex_cmp(const nd_job *J, int a, int b)
+{
+	int k;
+	double va, vb;
+	const double *ra, *rb;
+
+	if (J->sums[a] != J->sums[b])
+		return (J->sums[a] < J->sums[b]) ? -1 : 1;
+	ra = frontview_row(J->set, a);
+	rb = frontview_row(J->set, b);
+	for (k = 0; k < J->vlen; k++)
+	{
+		va = ra[k*J->set->cstride];
+		vb = rb[k*J->set->cstride];
+		if (va < vb)
+			return -1;
+		if (va > vb)
+			return 1;
+	}
+	return 0;
+}
+
+/* Whether a dominates b. Equal vectors don't dominate each other. */
+static inline int fast_dominates(const double *a, const double *b, int vlen)
+{
+	int k, better = 0;
+
+	for (k = 0; k < vlen; k++)
+	{
+		if (a[k] > b[k])
+			return 0;
+		better |= (a[k] < b[k]);
+	}
+	return better;
+}
+
+/* Sums the objectives of the vectors of a block, and sorts it with a bottom-up merge
+ * sort, using the block's part of the merge buffer */
+static void sort_task(nd_job *J, int b)
+{
+	int i, j, k, m, width, mid, hi, lo = J->bounds[b], end = J->bounds[b+1];
+	int *src = J->order, *dst = J->tmp, *swap;
+	double sum;
+
+	for (i = lo; i < end; i++)
+	{
+		sum = 0;
+		for (k = 0; k < J->vlen; k++)
+			sum += frontview_at(J->set, i, k);
+		J->sums[i] = sum;
+		J->order[i] = i;
+	}
+	for (width = 1; width < end - lo; width *= 2)
+	{
+		for (m = lo; m < end; m += 2*width)
+		{
+			mid = (m + width < end) ? m + width : end;
+			hi = (m + 2*width < end) ? m + 2*width : end;
+			i = m;
+			j = mid;
+			k = m;
+			while (i < mid && j < hi)
+				dst[k++] = (sum_lex_cmp(J, src[j], src[i]) < 0) ? src[j++] : src[i++];
+			while (i < mid)
+				dst[k++] = src[i++];
+			while (j < hi)
+				dst[k++] = src[j++];
+		}
+		swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != J->order)
+		memcpy(J->order + lo, src + lo, sizeof(int)*(end - lo));
+}
+
+/* Copies a sorted block, and filters it on its own */
+static void filter_task(nd_job *J, int b)
+{
+	int i, s, k, lo = J->bounds[b], hi = J->bounds[b+1], vlen = J->vlen;
+	int *surv = J->surv + lo, n = 0;
+	double *p;
+
+	for (i = lo; i < hi; i++)
+	{
+		p = J->P + (size_t)i*vlen;
+		for (k = 0; k < vlen; k++)
+			p[k] = frontview_at(J->set, J->order[i], k);
+		J->psums[i] = J->sums[J->order[i]];
+		for (s = 0; s < n; s++)
+			if (fast_dominates(J->P + (size_t)surv[s]*vlen, p, vlen))
+				break;
+		J->alive[i] = (s == n);
+		if (s == n)
+			surv[n++] = i;
+	}
+	J->nsurv[b] = n;
+}
+
+/* Checks the survivors of a block against those of every other block, up to the last
+ * one whose sum isn't larger */
+static void cross_task(nd_job *J, int b)
+{
+	int c, i, s, lo, hi, mid, pos, vlen = J->vlen;
+	const int *surv;
+	const double *p;
+
+	for (i = 0; i < J->nsurv[b]; i++)
+	{
+		pos = J->surv[J->bounds[b] + i];
+		p = J->P + (size_t)pos*vlen;
+		for (c = 0; c < J->nblocks && J->alive[pos]; c++)
+		{
+			if (c == b)
+				continue;
+			surv = J->surv + J->bounds[c];
+			for (lo = 0, hi = J->nsurv[c]; lo < hi; )
+			{
+				mid = (lo + hi) / 2;
+				if (J->psums[surv[mid]] <= J->psums[pos])
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			for (s = 0; s < lo; s++)
+			{
+				if (fast_dominates(J->P + (size_t)surv[s]*vlen, p, vlen))
+				{
+					J->alive[pos] = 0;
+					break;
+				}
+			}
+		}
+	}
+}
+
+static void *nd_worker(void *arg)
+{
+	nd_job *J = (nd_job*)arg;
+	int t;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&J->lock);
+		t = J->next++;
+		pthread_mutex_unlock(&J->lock);
+		if (t >= J->ntasks)
+			break;
+		J->task(J, t);
+	}
+	return NULL;
+}
+
+/* Runs the tasks of a stage, and waits for all of them */
+static void run_tasks(nd_job *J, nd_task task, int ntasks, int nthreads)
+{
+	int t;
+	pthread_t *threads;
+
+	J->task = task;
+	J->ntasks = ntasks;
+	J->next = 0;
+	if (nthreads > ntasks)
+		nthreads = ntasks;
+	if (nthreads <= 1)
+	{
+		nd_worker(J);
+		return;
+	}
+	threads = checked_malloc(sizeof(pthread_t)*nthreads);
+	for (t = 1; t < nthreads; t++)
+	{
+		if (pthread_create(&threads[t], NULL, &nd_worker, J))
+		{
+			perror("MOOUtils: Error creating worker thread");
+			exit(EXIT_FAILURE);
+		}
+	}
+	nd_worker(J);
+	for (t = 1; t < nthreads; t++)
+		pthread_join(threads[t], NULL);
+	free(threads);
+}
+
+int pareto_filter_parallel_view(const frontview_t *set, int *order, int nthreads)
+{
+	int b, i, n;
+	nd_job J;
+
+	if (set->len <= 0)
+		return 0;
+	if (nthreads < 1)
+		nthreads = 1;
+
+	J.set = set;
+	J.len = set->len;
+	J.vlen = set->vlen;
+	J.nblocks = set->len / NDFILTER_MIN_BLOCK;
+	if (J.nblocks > NDFILTER_BLOCKS_PER_THREAD*nthreads)
+		J.nblocks = NDFILTER_BLOCKS_PER_THREAD*nthreads;
+	if (nthreads == 1 || J.nblocks < 1)
+		J.nblocks = 1;
+	J.bounds = new_vector_int(J.nblocks + 1);
+	for (b = 0; b <= J.nblocks; b++)
+		J.bounds[b] = (int)((long)set->len*b / J.nblocks);
+	J.sums = new_vector_double(set->len);
+	J.order = new_vector_int(set->len);
+	J.tmp = new_vector_int(set->len);
+	J.P = new_vector_double((size_t)set->len*set->vlen + 1);
+	J.psums = new_vector_double(set->len);
+	J.surv = new_vector_int(set->len);
+	J.nsurv = new_vector_int(J.nblocks);
+	J.alive = checked_malloc(set->len);
+	pthread_mutex_init(&J.lock, NULL);
+
+	run_tasks(&J, &sort_task, J.nblocks, nthreads);
+	run_tasks(&J, &filter_task, J.nblocks, nthreads);
+	if (J.nblocks > 1)
+		run_tasks(&J, &cross_task, J.nblocks, nthreads);
+
+	// Non-dominated vectors first
+	for (n = 0, i = 0; i < set->len; i++)
+		if (J.alive[i])
+			order[n++] = J.order[i];
+	for (b = n, i = 0; i < set->len; i++)
+		if (!J.alive[i])
+			order[b++] = J.order[i];
+
+	pthread_mutex_destroy(&J.lock);
+	free_vector(J.bounds);
+	free_vector(J.sums);
+	free_vector(J.order);
+	free_vector(J.tmp);
+	free_vector(J.P);
+	free_vector(J.psums);
+	free_vector(J.surv);
+	free_vector(J.nsurv);
+	free(J.alive);
+	return n;
+}
+
+int pareto_filter_parallel(double **set, int setlen, int vlen, int nthreads)
+{
+	int i, n;
+	int *order;
+	double **rows;
+	frontview_t view;
+
+	if (setlen <= 0)
+		return 0;
+	order = new_vector_int(setlen);
+	rows = checked_malloc(sizeof(double*)*setlen);
+	view = frontview_matrix(set, setlen, vlen);
+
+	n = pareto_filter_parallel_view(&view, order, nthreads);
+	for (i = 0; i < setlen; i++)
+		rows[i] = set[order[i]];
+	for (i = 0; i < setlen; i++)
+		set[i] = rows[i];
+
+	free(rows);
+	free_vector(order);
+	return n;
+}
@@ -0,0 +1,315 @@
+/*
+ * nearest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "blockdist.h"
+#include "biobj.h"
+#include "kdtree.h"
+#include "nearest.h"
+
+nearest_index_t *nearest_index_build(const frontview_t *Y, const double *scale)
+{
+	nearest_index_t *I;
+
+	I = malloc(sizeof(nearest_index_t));
+	if (!I)
+	{
+		perror("MOOUtils: Out of memory when building nearest neighbour index");
+		exit(EXIT_FAILURE);
+	}
+	I->Y = *Y;
+	I->scale = scale;
+	I->S = NULL;
+	I->T = NULL;
+	if (Y->vlen == 2)
+		I->S = staircase_build(Y, scale);
+	else if (Y->vlen < BLOCKDIST_MIN_VLEN && Y->len >= KDTREE_MIN_LEN)
+		I->T = kdtree_build(Y, scale);
+	return I;
+}
+
+void nearest_index_query(const nearest_index_t *I, const frontview_t *X, int flags,
+		double *dists, int *nearest)
+{
+	int i, idx;
+	int distinct = (flags & NEAREST_DISTINCT) != 0;
+
+	if (I->S)
+	{
+		for (i = 0; i < X->len; i++)
+		{
+			dists[i] = staircase_nearest(I->S, frontview_at(X, i, 0), frontview_at(X, i, 1),
+					distinct, &idx);
+			if (nearest)
+				nearest[i] = idx;
+		}
+	}
+	else if (I->T)
+	{
+		for (i = 0; i < X->len; i++)
+		{
+			dists[i] = kdtree_nearest(I->T, frontview_row(X, i), X->cstride, distinct,
+					&idx);
+			if (nearest)
+				nearest[i] = idx;
+		}
+	}
+	else if (X->vlen >= BLOCKDIST_MIN_VLEN)
+	{
+		block_min_squared_dists(X, &I->Y, I->scale,
+				BLOCKDIST_EXACT | (distinct ? BLOCKDIST_DISTINCT : 0), dists, nearest);
+	}
+	else
+	{
+		for (i = 0; i < X->len; i++)
+		{
+			idx = view_closest_point(frontview_row(X, i), X->cstride, &I->Y, I->scale,
+					distinct, &dists[i]);
+			if (nearest)
+				nearest[i] = idx;
+		}
+	}
+}
+
+void nearest_index_query_approx(const nearest_index_t *I, const frontview_t *X,
+		double eps, double *dists, double *lower)
+{
+	int i;
+
+	if (I->S)
+	{
+		for (i = 0; i < X->len; i++)
+			dists[i] = staircase_nearest_approx(I->S, frontview_at(X, i, 0),
+					frontview_at(X, i, 1), eps, &lower[i], NULL);
+	}
+	else if (I->T)
+	{
+		for (i = 0; i < X->len; i++)
+			dists[i] = kdtree_nearest_approx(I->T, frontview_row(X, i), X->cstride, eps,
+					&lower[i], NULL);
+	}
+	else
+	{
+		// No structure to prune: the exact distances are their own bounds
+		nearest_index_query(I, X, 0, dists, NULL);
+		for (i = 0; i < X->len; i++)
+			lower[i] = dists[i];
+	}
+}
+
+void free_nearest_index(nearest_index_t *I)
+{
+	if (!I)
+		return;
+	free_staircase(I->S);
+	free_kdtree(I->T);
+	free(I);
+}
+
+void nearest_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int flags, double *dists, int *nearest)
+{
+	nearest_index_t *I;
+
+	I = nearest_index_build(Y, scale);
+	nearest_index_query(I, X, flags, dists, nearest);
+	free_nearest_index(I);
+}
+
+/* Search of the modified distance of GD+ and IGD+ through a kd-tree. The splits alone
+ * only bound one side of every region, so the bounding box of every node is kept, and
+ * the distance to a box is the modified distance to its lowest corner (when the tree's
+ * vectors count where greater than the query) or from its highest one. */
+typedef struct
+{
+	const kdtree_t *T;
+	const double *boxes;   /* per node: the lowest components, then the highest */
+	const double *x;       /* query vector and the distance between its components */
+	ptrdiff_t xs;
+	int side;
+	double bestd;
+}plus_query;
+
+static double *plus_boxes(const kdtree_t *T)
+{
+	int n, i, k, vlen = T->vlen;
+	double *box, *l, *r, *p;
+	double *boxes = new_vector_double((size_t)T->nnodes*2*vlen + 1);
+
+	// Children come after their parents, so the boxes are built backwards
+	for (n = T->nnodes - 1; n >= 0; n--)
+	{
+		box = boxes + (size_t)n*2*vlen;
+		if (T->nodes[n].left < 0)
+		{
+			for (k = 0; k < vlen; k++)
+				box[k] = box[vlen + k] = T->pts[(size_t)T->nodes[n].lo*vlen + k];
+			for (i = T->nodes[n].lo + 1; i < T->nodes[n].hi; i++)
+			{
+				p = T->pts + (size_t)i*vlen;
+				for (k = 0; k < vlen; k++)
+				{
+					if (p[k] < box[k])
+						box[k] = p[k];
+					if (p[k] > box[vlen + k])
+						box[vlen + k] = p[k];
+				}
+			}
+			continue;
+		}
+		l = boxes + (size_t)T->nodes[n].left*2*vlen;
+		r = boxes + (size_t)T->nodes[n].right*2*vlen;
+		for (k = 0; k < vlen; k++)
+		{
+			box[k] = (l[k] < r[k]) ? l[k] : r[k];
+			box[vlen + k] = (l[vlen + k] > r[vlen + k]) ? l[vlen + k] : r[vlen + k];
+		}
+	}
+	return boxes;
+}
+
+static inline double plus_dist(const plus_query *Q, const double *p)
+{
+	if (Q->side > 0)
+		return strided_plus_squared_dist(Q->x, Q->xs, p, 1, Q->T->vlen, Q->T->scale);
+	return strided_plus_squared_dist(p, 1, Q->x, Q->xs, Q->T->vlen, Q->T->scale);
+}
+
+static inline double plus_box_dist(const plus_query *Q, int node)
+{
+	const double *box = Q->boxes + (size_t)node*2*Q->T->vlen;
+	return plus_dist(Q, (Q->side > 0) ? box : box + Q->T->vlen);
+}
+
+/* Searches the subtree of a node, the child with the nearest box first */
+static void plus_search_node(plus_query *Q, int node)
+{
+	int i, first, second;
+	double d, dl, dr;
+	const kdnode_t *N = &Q->T->nodes[node];
+
+	if (N->left < 0)
+	{
+		for (i = N->lo; i < N->hi; i++)
+		{
+			d = plus_dist(Q, Q->T->pts + (size_t)i*Q->T->vlen);
+			if (d < Q->bestd)
+				Q->bestd = d;
+		}
+		return;
+	}
+	dl = plus_box_dist(Q, N->left);
+	dr = plus_box_dist(Q, N->right);
+	if (dl <= dr)
+	{
+		first = N->left;
+		second = N->right;
+	}
+	else
+	{
+		first = N->right;
+		second = N->left;
+		d = dl;
+		dl = dr;
+		dr = d;
+	}
+	// Once a vector at distance 0 is found, every box is skipped
+	if (dl < Q->bestd)
+		plus_search_node(Q, first);
+	if (dr < Q->bestd)
+		plus_search_node(Q, second);
+}
+
+void nearest_plus_squared_dists(const frontview_t *X, const frontview_t *Y,
+		const double *scale, int side, double *dists)
+{
+	int i, j;
+	double d;
+	const double *x, *y;
+	plus_query Q;
+	kdtree_t *T;
+
+	if (Y->len >= KDTREE_MIN_LEN)
+	{
+		T = kdtree_build(Y, scale);
+		Q.T = T;
+		Q.boxes = plus_boxes(T);
+		Q.xs = X->cstride;
+		Q.side = side;
+		for (i = 0; i < X->len; i++)
+		{
+			Q.x = frontview_row(X, i);
+			Q.bestd = DBL_MAX;
+			plus_search_node(&Q, 0);
+			dists[i] = Q.bestd;
+		}
+		free_vector((double*)Q.boxes);
+		free_kdtree(T);
+		return;
+	}
+	for (i = 0; i < X->len; i++)
+	{
+		x = frontview_row(X, i);
+		dists[i] = DBL_MAX;
+		for (j = 0; j < Y->len; j++)
+		{
+			y = frontview_row(Y, j);
+			if (side > 0)
+				d = strided_plus_squared_dist(x, X->cstride, y, Y->cstride, X->vlen, scale);
+			else
+				d = strided_plus_squared_dist(y, Y->cstride, x, X->cstride, X->vlen, scale);
+			if (d < dists[i])
+				dists[i] = d;
+		}
+	}
+}
+
+void all_nearest_neighbours_view(const frontview_t *set, const double *scale,
+		double *dists, int *nearest)
+{
+	kdtree_t *T;
+
+	/* Bi-objective and many-objective sets are handled as well by the general search,
+	 * since the staircase and the blocked engine work on the whole set at once */
+	if (set->vlen == 2 || set->vlen >= BLOCKDIST_MIN_VLEN || set->len < KDTREE_MIN_LEN)
+	{
+		nearest_squared_dists(set, set, scale, NEAREST_DISTINCT, dists, nearest);
+		return;
+	}
+	T = kdtree_build(set, scale);
+	kdtree_all_nearest(T, dists, nearest);
+	free_kdtree(T);
+}
+
+void all_nearest_neighbours(double **set, int setlen, int vlen, double *dists,
+		int *nearest)
+{
+	frontview_t view = frontview_matrix(set, setlen, vlen);
+	all_nearest_neighbours_view(&view, NULL, dists, nearest);
+}
@@ -0,0 +1,460 @@
+/*
+ * pairwise.c
+ *
+ * Pairwise indicator matrices. Every set is prepared once: its vectors are copied into
+ * a contiguous buffer sorted by the first objective, and its bounding box is kept.
+ * Then the pairs are handed out one at a time to a pool of threads, each of them
+ * writing its own entries of the matrix.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
+#include <pthread.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "epsilon.h"
+#include "pairwise.h"
+
+/* A set prepared for pairwise comparisons */
+typedef struct
+{
+	int len;
+	int vlen;
+	int descending;
+	double *pts;   /* len*vlen components, sorted by the first objective */
+	double *min;   /* bounding box */
+	double *max;
+	double *best;  /* len*vlen: for the epsilon indicator, the value of each objective
+	                  (but the first) most favourable to B among the vectors up to each
+	                  one, or NULL */
+}sorted_set;
+
+typedef enum
+{
+	epsilon_task,
+	coverage_task
+}pair_task;
+
+/* State shared by the threads computing a matrix */
+typedef struct
+{
+	const sorted_set *sets;
+	int nsets;
+	pair_task task;
+	epsilon_t method;
+	double *M;
+	pthread_mutex_t lock;
+	long next;     /* next pair to compute */
+}pair_job;
+
+/* Copies a set sorted by its first objective. For the epsilon indicator, the objectives
+ * whose values are negative are flagged (a multiplicative epsilon term decreases as
+ * their values go up, and the set is sorted in descending order if the first one is);
+ * otherwise, negative is NULL. */
+static void prepare_set(const frontview_t *set, const int *negative, sorted_set *S)
+{
+	int i, k, src, vlen = set->vlen;
+	int *order = new_vector_int(set->len + 1);
+	double v, *row, *prev;
+
+	S->len = set->len;
+	S->vlen = vlen;
+	S->descending = negative && negative[0];
+	S->pts = new_vector_double((size_t)set->len*vlen + 1);
+	S->min = new_vector_double(vlen);
+	S->max = new_vector_double(vlen);
+	for (k = 0; k < vlen; k++)
+	{
+		S->min[k] = DBL_MAX;
+		S->max[k] = -DBL_MAX;
+	}
+
+	lexicographical_order(set, order);
+	for (i = 0; i < set->len; i++)
+	{
+		src = S->descending ? order[set->len - 1 - i] : order[i];
+		for (k = 0; k < vlen; k++)
+		{
+			v = frontview_at(set, src, k);
+			S->pts[(size_t)i*vlen + k] = v;
+			S->min[k] = (v < S->min[k]) ? v : S->min[k];
+			S->max[k] = (v > S->max[k]) ? v : S->max[k];
+		}
+	}
+	free_vector(order);
+
+	S->best = NULL;
+	if (!negative)
+		return;
+	S->best = new_vector_double((size_t)set->len*vlen + 1);
+	for (i = 0; i < set->len; i++)
+	{
+		row = S->pts + (size_t)i*vlen;
+		prev = S->best + (size_t)(i - 1)*vlen;
+		for (k = 1; k < vlen; k++)
+		{
+			v = row[k];
+			if (i > 0 && (negative[k] ? prev[k] > v : prev[k] < v))
+				v = prev[k];
+			S->best[(size_t)i*vlen + k] = v;
+		}
+	}
+}
+
+static sorted_set *prepare_sets(const frontview_t *sets, int nsets, const int *negative)
+{
+	int s;
+	sorted_set *S = checked_malloc(sizeof(sorted_set)*nsets);
+
+	for (s = 0; s < nsets; s++)
+		prepare_set(&sets[s], negative, &S[s]);
+	return S;
+}
+
+static void free_set(sorted_set *S)
+{
+	free_vector(S->pts);
+	free_vector(S->min);
+	free_vector(S->max);
+	if (S->best)
+		free_vector(S->best);
+}
+
+static void free_sets(sorted_set *S, int nsets)
+{
+	int s;
+
+	for (s = 0; s < nsets; s++)
+		free_set(&S[s]);
+	free(S);
+}
+
+static inline double epsilon_term(double b, double a, epsilon_t method)
+{
+	return (method == additive_e) ? b - a : b / a;
+}
+
+/* Same as epsilon_view, with both sets sorted the same way. The search for the best
+ * match of a vector of A in B starts where the first objective of B reaches a's, and
+ * goes both ways: forward, the first objective's term of the epsilon value only grows,
+ * and backwards, the running best values of the other objectives only get worse, so
+ * each way stops once its bound reaches the best value found. Neighbouring vectors of
+ * A tend to share their best match, which makes a good first guess for the next one
+ * (see epsilon_view_hint). Minima and maxima don't depend on the order the values are
+ * visited in, so the result is exactly the one of epsilon_view. */
+static double sorted_epsilon(const sorted_set *A, const sorted_set *B, epsilon_t method)
+{
+	int i, j, k, lo, hi, mid, have_eps, guess, vlen = A->vlen;
+	const double *a, *b;
+	double eps, eps_j, eps_k, bound;
+
+	eps = (method == additive_e) ? DBL_MIN : 0;
+	// No pairs at all, as in epsilon_view
+	if (B->len == 0)
+		return (A->len > 0) ? 0 : eps;
+	have_eps = 0;
+	guess = -1;
+	for (i = 0; i < A->len; i++)
+	{
+		a = A->pts + (size_t)i*vlen;
+		eps_j = DBL_MAX;
+		if (guess >= 0)
+		{
+			eps_j = epsilon_pair(a, 1, B->pts + (size_t)guess*vlen, 1, vlen, method,
+					DBL_MAX);
+			if (eps_j <= eps)
+				continue;
+		}
+
+		lo = 0;
+		hi = B->len;
+		while (lo < hi)
+		{
+			mid = lo + (hi - lo)/2;
+			if (B->descending ? B->pts[(size_t)mid*vlen] > a[0] :
+					B->pts[(size_t)mid*vlen] < a[0])
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		for (j = lo; j < B->len; j++)
+		{
+			b = B->pts + (size_t)j*vlen;
+			if (epsilon_term(b[0], a[0], method) >= eps_j)
+				break;
+			eps_k = epsilon_pair(a, 1, b, 1, vlen, method, eps_j);
+			if (eps_k < eps_j)
+			{
+				eps_j = eps_k;
+				guess = j;
+				if (have_eps && eps_j <= eps)
+					break;
+			}
+		}
+		if (have_eps && eps_j <= eps)
+			continue;
+		for (j = lo - 1; j >= 0; j--)
+		{
+			b = B->best + (size_t)j*vlen;
+			for (k = 1, bound = -DBL_MAX; k < vlen && bound < eps_j; k++)
+			{
+				eps_k = epsilon_term(b[k], a[k], method);
+				bound = (eps_k > bound) ? eps_k : bound;
+			}
+			if (bound >= eps_j)
+				break;
+			eps_k = epsilon_pair(a, 1, B->pts + (size_t)j*vlen, 1, vlen, method, eps_j);
+			if (eps_k < eps_j)
+			{
+				eps_j = eps_k;
+				guess = j;
+				if (have_eps && eps_j <= eps)
+					break;
+			}
+		}
+		if (!have_eps || eps < eps_j)
+			eps = eps_j;
+		have_eps = 1;
+	}
+	return eps;
+}
+
+/* Set coverage with A sorted in ascending order: only the vectors of A whose first
+ * objective isn't above b's can weakly dominate b */
+static double sorted_coverage(const sorted_set *A, const sorted_set *B)
+{
+	int i, j, k, covered, vlen = A->vlen, inside;
+	const double *a, *b;
+
+	if (B->len == 0)
+		return 0;
+	if (A->len == 0)
+		return 0;
+
+	// Disjoint boxes: no vector of A weakly dominates any of B
+	for (k = 0; k < vlen; k++)
+		if (B->max[k] < A->min[k])
+			return 0;
+	// Every vector of A weakly dominates every vector of B
+	for (k = 0; k < vlen && A->max[k] <= B->min[k]; k++)
+		;
+	if (k == vlen)
+		return 1;
+
+	covered = 0;
+	for (j = 0; j < B->len; j++)
+	{
+		b = B->pts + (size_t)j*vlen;
+		inside = 1;
+		for (k = 0; k < vlen && inside; k++)
+			inside = (b[k] >= A->min[k]);
+		if (!inside)
+			continue;
+		for (i = 0; i < A->len; i++)
+		{
+			a = A->pts + (size_t)i*vlen;
+			if (a[0] > b[0])
+				break;
+			for (k = 1; k < vlen && a[k] <= b[k]; k++)
+				;
+			if (k == vlen)
+			{
+				covered++;
+				break;
+			}
+		}
+	}
+	return (double)covered / B->len;
+}
+
+static void *pair_worker(void *arg)
+{
+	pair_job *J = (pair_job*)arg;
+	long p, n2 = (long)J->nsets*J->nsets;
+	const sorted_set *A, *B;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&J->lock);
+		p = J->next++;
+		pthread_mutex_unlock(&J->lock);
+		if (p >= n2)
+			break;
+		A = &J->sets[p / J->nsets];
+		B = &J->sets[p % J->nsets];
+		if (J->task == epsilon_task)
+			J->M[p] = sorted_epsilon(A, B, J->method);
+		else
+			J->M[p] = sorted_coverage(A, B);
+	}
+	return NULL;
+}
+
+/* Computes every entry of a matrix over prepared sets */
+static void run_pairs(sorted_set *sets, int nsets, pair_task task,
+		epsilon_t method, int nthreads, double *M)
+{
+	int t;
+	long n2 = (long)nsets*nsets;
+	pthread_t *threads;
+	pair_job J;
+
+	J.sets = sets;
+	J.nsets = nsets;
+	J.task = task;
+	J.method = method;
+	J.M = M;
+	J.next = 0;
+	pthread_mutex_init(&J.lock, NULL);
+
+	if (nthreads > n2)
+		nthreads = (int)n2;
+	if (nthreads <= 1)
+	{
+		pair_worker(&J);
+		pthread_mutex_destroy(&J.lock);
+		return;
+	}
+	threads = checked_malloc(sizeof(pthread_t)*nthreads);
+	for (t = 0; t < nthreads; t++)
+	{
+		if (pthread_create(&threads[t], NULL, &pair_worker, &J))
+		{
+			perror("MOOUtils: Error creating worker thread");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (t = 0; t < nthreads; t++)
+		pthread_join(threads[t], NULL);
+	free(threads);
+	pthread_mutex_destroy(&J.lock);
+}
+
+/* Every set is paired with every other one, so checking each of them against the first
+ * vector of some set (see epsilon_valid_multiplicative) is the same as checking every
+ * pair. The objectives whose values are negative are flagged. */
+static void check_multiplicative(const frontview_t *sets, int nsets, int *negative)
+{
+	int s, k, first;
+	frontview_t head;
+
+	for (first = 0; first < nsets && sets[first].len == 0; first++)
+		;
+	if (first == nsets)
+		return;
+	head = sets[first];
+	head.len = 1;
+	for (s = first; s < nsets; s++)
+	{
+		if (!epsilon_valid_multiplicative(&sets[s], &head))
+		{
+			perror("MOOUtils: Error in data.");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (k = 0; k < head.vlen; k++)
+		negative[k] = (frontview_at(&head, 0, k) < 0);
+}
+
+void epsilon_matrix_view(const frontview_t *sets, int nsets, epsilon_t method,
+		int nthreads, double *M)
+{
+	int *negative;
+	sorted_set *S;
+
+	if (nsets <= 0)
+		return;
+	negative = new_vector_int(sets[0].vlen);
+	switch (method)
+	{
+		case additive_e:
+			break;
+		case multiplicative_e:
+			check_multiplicative(sets, nsets, negative);
+			break;
+		default:
+			perror("MOOUtils: Invalid option.");
+			exit(EXIT_FAILURE);
+	}
+
+	S = prepare_sets(sets, nsets, negative);
+	run_pairs(S, nsets, epsilon_task, method, nthreads, M);
+	free_sets(S, nsets);
+	free_vector(negative);
+}
+
+void epsilon_matrix(double ***sets, const int *setlens, int nsets, int vlen,
+		epsilon_t method, int nthreads, double *M)
+{
+	int s;
+	frontview_t *views = checked_malloc(sizeof(frontview_t)*nsets);
+	for (s = 0; s < nsets; s++)
+		views[s] = frontview_matrix(sets[s], setlens[s], vlen);
+	epsilon_matrix_view(views, nsets, method, nthreads, M);
+	free(views);
+}
+
+double set_coverage_view(const frontview_t *A, const frontview_t *B)
+{
+	double res;
+	sorted_set SA, SB;
+
+	prepare_set(A, NULL, &SA);
+	prepare_set(B, NULL, &SB);
+	res = sorted_coverage(&SA, &SB);
+	free_set(&SA);
+	free_set(&SB);
+	return res;
+}
+
+double set_coverage(double **A, int Alen, double **B, int Blen, int vlen)
+{
+	frontview_t a = frontview_matrix(A, Alen, vlen);
+	frontview_t b = frontview_matrix(B, Blen, vlen);
+	return set_coverage_view(&a, &b);
+}
+
+void coverage_matrix_view(const frontview_t *sets, int nsets, int nthreads, double *M)
+{
+	sorted_set *S;
+
+	if (nsets <= 0)
+		return;
+	S = prepare_sets(sets, nsets, NULL);
+	run_pairs(S, nsets, coverage_task, additive_e, nthreads, M);
+	free_sets(S, nsets);
+}
+
+void coverage_matrix(double ***sets, const int *setlens, int nsets, int vlen,
+		int nthreads, double *M)
+{
+	int s;
+	frontview_t *views = checked_malloc(sizeof(frontview_t)*nsets);
+	for (s = 0; s < nsets; s++)
+		views[s] = frontview_matrix(sets[s], setlens[s], vlen);
+	coverage_matrix_view(views, nsets, nthreads, M);
+	free(views);
+}
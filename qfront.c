@@ -0,0 +1,334 @@
+/*
+ * qfront.c
+ *
+ * Quantized reference fronts. Distances are measured on the codes themselves: with
+ * a[k] = step[k]*scale[k] and b[k] = (x[k] - min[k])*scale[k] worked out once per
+ * query, the normalized difference in objective k is just code*a[k] - b[k], so the
+ * inner loops read 2 or 4 bytes per value and nothing is decoded. Vectors are stored in
+ * Z-order of their codes, so every block of consecutive vectors covers a small box,
+ * and blocks whose box is farther than the best distance found are skipped.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <errno.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "qfront.h"
+
+static uint32_t quantize(double v, double min, double step, double maxcode)
+{
+	double c;
+
+	if (step == 0)
+		return 0;
+	c = floor((v - min) / step + 0.5);
+	if (c < 0)
+		c = 0;
+	if (c > maxcode)
+		c = maxcode;
+	return (uint32_t)c;
+}
+
+static inline double code_at(const void *codes, int bits, size_t i)
+{
+	return (bits == 16) ? ((const uint16_t*)codes)[i] : ((const uint32_t*)codes)[i];
+}
+
+static inline void put_code(void *codes, int bits, size_t i, uint32_t c)
+{
+	if (bits == 16)
+		((uint16_t*)codes)[i] = (uint16_t)c;
+	else
+		((uint32_t*)codes)[i] = c;
+}
+
+/* Sorts the indices of the vectors by a 64-bit key, with a radix sort of 16-bit digits */
+static void sort_by_key(const uint64_t *keys, int len, int *order)
+{
+	int i, d, shift, *tmp, *src, *dst, *swap;
+	int *counts = new_vector_int(65536 + 1);
+
+	tmp = new_vector_int(len);
+	for (i = 0; i < len; i++)
+		order[i] = i;
+	src = order;
+	dst = tmp;
+	for (shift = 0; shift < 64; shift += 16)
+	{
+		memset(counts, 0, sizeof(int)*(65536 + 1));
+		for (i = 0; i < len; i++)
+			counts[((keys[src[i]] >> shift) & 0xffff) + 1]++;
+		if (counts[(keys[src[0]] >> shift & 0xffff) + 1] == len)
+			continue;
+		for (d = 0; d < 65536; d++)
+			counts[d+1] += counts[d];
+		for (i = 0; i < len; i++)
+			dst[counts[(keys[src[i]] >> shift) & 0xffff]++] = src[i];
+		swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != order)
+		memcpy(order, src, sizeof(int)*len);
+	free_vector(tmp);
+	free_vector(counts);
+}
+
+/* Z-order key of a vector of codes: the top bits of every code (of the first 64
+ * objectives), interleaved */
+static uint64_t zorder_key(const uint32_t *codes, int vlen, int bits)
+{
+	int b, k, n = (vlen < 64) ? vlen : 64, per = 64 / n;
+	uint64_t key = 0;
+
+	if (per > bits)
+		per = bits;
+	for (b = 1; b <= per; b++)
+		for (k = 0; k < n; k++)
+			key = (key << 1) | ((codes[k] >> (bits - b)) & 1);
+	return key;
+}
+
+qfront_t *qfront_build(const frontview_t *truefront, int bits)
+{
+	int i, k, len = truefront->len, vlen = truefront->vlen;
+	int *order;
+	size_t box;
+	uint32_t c, *raw;
+	uint64_t *keys;
+	double maxcode, v, err, sum;
+	double *max;
+	qfront_t *Q;
+
+	if (bits != 16 && bits != 32)
+	{
+		perror("MOOUtils: Invalid option.");
+		exit(EXIT_FAILURE);
+	}
+	if (len <= 0)
+	{
+		errno = EINVAL;
+		perror("MOOUtils: Error in data.");
+		exit(EXIT_FAILURE);
+	}
+
+	Q = checked_malloc(sizeof(qfront_t));
+	Q->len = len;
+	Q->vlen = vlen;
+	Q->bits = bits;
+	Q->min = new_vector_double(vlen);
+	Q->step = new_vector_double(vlen);
+	Q->scale = new_vector_double(vlen);
+	Q->max_error = new_vector_double(vlen);
+	Q->codes = checked_malloc((size_t)len*vlen*(bits / 8));
+
+	/* Same bounds and scale factors view_norm_scale gives for the original front, but
+	 * for objectives with a single value: their scale factor is 0, so they don't add to
+	 * any distance, here or in the searches through a nearest_index_t */
+	max = new_vector_double(vlen);
+	view_bounds(truefront, Q->min, max);
+	maxcode = (bits == 16) ? 65535.0 : 4294967295.0;
+	for (k = 0; k < vlen; k++)
+	{
+		Q->scale[k] = (max[k] > Q->min[k]) ? 1.0 / (max[k] - Q->min[k]) : 0;
+		Q->step[k] = (max[k] - Q->min[k]) / maxcode;
+		Q->max_error[k] = 0;
+	}
+
+	/* Codes are worked out first, and then stored in Z-order, a block at a time, along
+	 * with the block's bounding box */
+	raw = checked_malloc(sizeof(uint32_t)*len*vlen);
+	keys = checked_malloc(sizeof(uint64_t)*len);
+	order = new_vector_int(len);
+	for (i = 0; i < len; i++)
+	{
+		for (k = 0; k < vlen; k++)
+		{
+			v = frontview_at(truefront, i, k);
+			c = quantize(v, Q->min[k], Q->step[k], maxcode);
+			raw[(size_t)i*vlen + k] = c;
+			err = fabs(v - (Q->min[k] + c*Q->step[k]));
+			if (err > Q->max_error[k])
+				Q->max_error[k] = err;
+		}
+		keys[i] = zorder_key(raw + (size_t)i*vlen, vlen, bits);
+	}
+	sort_by_key(keys, len, order);
+
+	Q->nblocks = (len + QFRONT_BLOCK - 1) / QFRONT_BLOCK;
+	Q->boxes = checked_malloc((size_t)Q->nblocks*2*vlen*(bits / 8));
+	for (i = 0; i < len; i++)
+	{
+		box = (size_t)(i / QFRONT_BLOCK)*2*vlen;
+		for (k = 0; k < vlen; k++)
+		{
+			c = raw[(size_t)order[i]*vlen + k];
+			put_code(Q->codes, bits, (size_t)i*vlen + k, c);
+			if (i % QFRONT_BLOCK == 0 || c < code_at(Q->boxes, bits, box + k))
+				put_code(Q->boxes, bits, box + k, c);
+			if (i % QFRONT_BLOCK == 0 || c > code_at(Q->boxes, bits, box + vlen + k))
+				put_code(Q->boxes, bits, box + vlen + k, c);
+		}
+	}
+
+	// Every normalized difference changes by at most max_error*scale
+	sum = 0;
+	for (k = 0; k < vlen; k++)
+		if (Q->step[k] > 0)
+			sum += (Q->max_error[k]*Q->scale[k]) * (Q->max_error[k]*Q->scale[k]);
+	Q->dist_error = sqrt(sum);
+
+	free(raw);
+	free(keys);
+	free_vector(order);
+	free_vector(max);
+	return Q;
+}
+
+size_t qfront_size(const qfront_t *Q)
+{
+	return sizeof(qfront_t) + sizeof(double)*4*Q->vlen +
+			((size_t)Q->len + 2*(size_t)Q->nblocks)*Q->vlen*(Q->bits / 8);
+}
+
+void qfront_decode(const qfront_t *Q, int first, int n, double *out)
+{
+	int i, k;
+	size_t c;
+
+	for (i = 0; i < n; i++)
+	{
+		c = (size_t)(first + i)*Q->vlen;
+		for (k = 0; k < Q->vlen; k++)
+			out[(size_t)i*Q->vlen + k] = Q->min[k] + code_at(Q->codes, Q->bits, c + k)*Q->step[k];
+	}
+}
+
+/* Squared distance from a query to the nearest vector of a block, if nearer than best */
+static inline __attribute__((always_inline)) double scan_block(const qfront_t *Q,
+		const double *a, const double *b, int blk, double best, int bits)
+{
+	int i, k, end, vlen = Q->vlen;
+	size_t row;
+	double d, sum;
+
+	end = (blk + 1)*QFRONT_BLOCK;
+	if (end > Q->len)
+		end = Q->len;
+	for (i = blk*QFRONT_BLOCK; i < end; i++)
+	{
+		row = (size_t)i*vlen;
+		sum = 0;
+		for (k = 0; k < vlen && sum < best; k++)
+		{
+			d = code_at(Q->codes, bits, row + k)*a[k] - b[k];
+			sum += d*d;
+		}
+		if (sum < best)
+			best = sum;
+	}
+	return best;
+}
+
+/* Squared distance from a query to the nearest stored vector. The distance to every
+ * block's box is worked out first; the nearest block is scanned, and then every other
+ * block whose box is nearer than the best distance found. The body is specialized for
+ * each code width. */
+static inline __attribute__((always_inline)) double search_body(const qfront_t *Q,
+		const double *a, const double *b, double *lb, int bits)
+{
+	int blk, k, first = 0, vlen = Q->vlen;
+	size_t box;
+	double d, sum, best;
+
+	for (blk = 0; blk < Q->nblocks; blk++)
+	{
+		box = (size_t)blk*2*vlen;
+		sum = 0;
+		for (k = 0; k < vlen; k++)
+		{
+			d = b[k] - code_at(Q->boxes, bits, box + vlen + k)*a[k];
+			if (d <= 0)
+				d = code_at(Q->boxes, bits, box + k)*a[k] - b[k];
+			if (d > 0)
+				sum += d*d;
+		}
+		lb[blk] = sum;
+		if (sum < lb[first])
+			first = blk;
+	}
+	best = scan_block(Q, a, b, first, DBL_MAX, bits);
+	for (blk = 0; blk < Q->nblocks; blk++)
+		if (lb[blk] < best && blk != first)
+			best = scan_block(Q, a, b, blk, best, bits);
+	return best;
+}
+
+static double search_16(const qfront_t *Q, const double *a, const double *b, double *lb)
+{
+	return search_body(Q, a, b, lb, 16);
+}
+
+static double search_32(const qfront_t *Q, const double *a, const double *b, double *lb)
+{
+	return search_body(Q, a, b, lb, 32);
+}
+
+void qfront_nearest_squared_dists(const qfront_t *Q, const frontview_t *X, double *dists)
+{
+	int i, k, vlen = Q->vlen;
+	double *a = new_vector_double(vlen), *b = new_vector_double(vlen);
+	double *lb = new_vector_double(Q->nblocks);
+
+	// Objectives with a single value have null scale factors (see qfront_build)
+	for (k = 0; k < vlen; k++)
+		a[k] = Q->step[k]*Q->scale[k];
+	for (i = 0; i < X->len; i++)
+	{
+		for (k = 0; k < vlen; k++)
+			b[k] = (frontview_at(X, i, k) - Q->min[k])*Q->scale[k];
+		dists[i] = (Q->bits == 16) ? search_16(Q, a, b, lb) : search_32(Q, a, b, lb);
+	}
+	free_vector(a);
+	free_vector(b);
+	free_vector(lb);
+}
+
+void free_qfront(qfront_t *Q)
+{
+	if (!Q)
+		return;
+	free_vector(Q->min);
+	free_vector(Q->step);
+	free_vector(Q->scale);
+	free_vector(Q->max_error);
+	free(Q->codes);
+	free(Q->boxes);
+	free(Q);
+}
@@ -0,0 +1,277 @@
+/*
+ * r2.c
+ *
+ * R2 indicator. The utility of every vector for every weight is a max over the
+ * objectives followed by a min over the vectors, so with the distances to the ideal
+ * point stored objective by objective, a block of weights is reduced against one
+ * vector at a time with each weight in its own lane, and nothing but comparisons and
+ * products is involved, which vectorize without changing the results.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include <pthread.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "cpudispatch.h"
+#include "r2.h"
+
+// Weights reduced together (one per lane), and vectors per cache block
+#define R2_WBLOCK 8
+#define R2_PBLOCK 1024
+
+typedef void (*r2_kernel_fn)(const double *D, int len, int vlen, const double *wp,
+		int p0, int p1, double *mins);
+
+/* Work shared by the threads: each one takes a range of weight blocks */
+typedef struct
+{
+	const double *D;     /* vlen*len distances to the ideal point, objective by objective */
+	int len;
+	int vlen;
+	const double *Wp;    /* weight blocks, objective by objective, R2_WBLOCK lanes each */
+	double *mins;        /* smallest utility found for every weight */
+	int b0, b1;          /* range of weight blocks */
+	r2_kernel_fn kernel;
+}r2_task;
+
+int simplex_lattice_size(int vlen, int divisions)
+{
+	int k;
+	double n = 1;
+
+	// (divisions + vlen - 1) choose (vlen - 1), computed incrementally
+	for (k = 1; k < vlen; k++)
+		n = n * (divisions + k) / k;
+	return (int)(n + 0.5);
+}
+
+double *simplex_lattice_weights(int vlen, int divisions, int *nweights)
+{
+	int n, w, j, k, tail;
+	int *c = new_vector_int(vlen);
+	double *W;
+
+	n = simplex_lattice_size(vlen, divisions);
+	W = new_vector_double((size_t)n*vlen + 1);
+
+	/* Compositions of divisions into vlen parts, in lexicographical order, from
+	 * (0, ..., 0, divisions) on. The next one adds a unit to the rightmost part that
+	 * has something after it, and moves all of that but the unit to the last part. */
+	c[vlen-1] = divisions;
+	for (w = 0; w < n; w++)
+	{
+		for (k = 0; k < vlen; k++)
+			W[(size_t)w*vlen + k] = (double)c[k] / divisions;
+		if (w == n - 1)
+			break;
+		if (c[vlen-1] > 0)
+			j = vlen - 2;
+		else
+		{
+			for (j = vlen - 2; c[j] == 0; j--)
+				;
+			j--;
+		}
+		tail = 0;
+		for (k = j + 1; k < vlen; k++)
+		{
+			tail += c[k];
+			c[k] = 0;
+		}
+		c[j]++;
+		c[vlen-1] = tail - 1;
+	}
+	free_vector(c);
+	if (nweights)
+		*nweights = n;
+	return W;
+}
+
+/* Reduces a block of weights against the vectors p0..p1-1, updating the smallest
+ * utility of every weight. There's one lane per weight, in vectors as wide as each
+ * instruction set variant handles natively. Plain ternaries over the lanes aren't
+ * vectorized by the compiler (only when it can ignore NaNs and signed zeros), so the
+ * selections are spelled out as masks, which give the same results. */
+#define R2_KERNEL(name, target, lanes)                                                 \
+typedef double name##_vec __attribute__((vector_size(lanes*sizeof(double))));          \
+typedef long long name##_mask __attribute__((vector_size(lanes*sizeof(long long))));  \
+static target void name(const double *D, int len, int vlen, const double *wp,          \
+		int p0, int p1, double *mins)                                                  \
+{                                                                                      \
+	int i, k, j;                                                                       \
+	double d;                                                                          \
+	name##_vec w, t, u[R2_WBLOCK/lanes], m[R2_WBLOCK/lanes];                           \
+	name##_mask sel;                                                                   \
+                                                                                       \
+	__builtin_memcpy(m, mins, sizeof(m));                                              \
+	for (i = p0; i < p1; i++)                                                          \
+	{                                                                                  \
+		d = D[i];                                                                      \
+		for (j = 0; j < R2_WBLOCK/lanes; j++)                                          \
+		{                                                                              \
+			__builtin_memcpy(&w, wp + lanes*j, sizeof(w));                             \
+			u[j] = w * d;                                                              \
+		}                                                                              \
+		for (k = 1; k < vlen; k++)                                                     \
+		{                                                                              \
+			d = D[(size_t)k*len + i];                                                  \
+			for (j = 0; j < R2_WBLOCK/lanes; j++)                                      \
+			{                                                                          \
+				__builtin_memcpy(&w, wp + k*R2_WBLOCK + lanes*j, sizeof(w));           \
+				t = w * d;                                                             \
+				sel = (t > u[j]);                                                      \
+				u[j] = (name##_vec)(((name##_mask)t & sel) | ((name##_mask)u[j] & ~sel)); \
+			}                                                                          \
+		}                                                                              \
+		for (j = 0; j < R2_WBLOCK/lanes; j++)                                          \
+		{                                                                              \
+			sel = (u[j] < m[j]);                                                       \
+			m[j] = (name##_vec)(((name##_mask)u[j] & sel) | ((name##_mask)m[j] & ~sel)); \
+		}                                                                              \
+	}                                                                                  \
+	__builtin_memcpy(mins, m, sizeof(m));                                              \
+}
+
+R2_KERNEL(r2_kernel, , 2)
+#if MOO_ISA_VARIANTS
+R2_KERNEL(r2_kernel_avx2, MOO_TARGET_AVX2, 4)
+R2_KERNEL(r2_kernel_avx512, MOO_TARGET_AVX512, 8)
+#endif
+
+/* Goes over the vectors one cache block at a time, reducing every weight block of the
+ * task against each of them */
+static void *r2_worker(void *arg)
+{
+	r2_task *T = (r2_task*)arg;
+	int p0, p1, b;
+
+	for (p0 = 0; p0 < T->len; p0 += R2_PBLOCK)
+	{
+		p1 = (T->len - p0 < R2_PBLOCK) ? T->len : p0 + R2_PBLOCK;
+		for (b = T->b0; b < T->b1; b++)
+			T->kernel(T->D, T->len, T->vlen, T->Wp + (size_t)b*T->vlen*R2_WBLOCK, p0, p1,
+					T->mins + (size_t)b*R2_WBLOCK);
+	}
+	return NULL;
+}
+
+double r2_indicator_view(const frontview_t *front, const frontview_t *weights,
+		const double *ideal, int nthreads)
+{
+	int i, k, l, w, t, nblocks, len = front->len, vlen = front->vlen;
+	double *D, *Wp, *mins, sum;
+	r2_task *tasks;
+	pthread_t *threads;
+	r2_kernel_fn kernel = &r2_kernel;
+
+	if (weights->len == 0)
+		return 0;
+	if (len == 0)
+		return DBL_MAX;
+
+#if MOO_ISA_VARIANTS
+	switch (moo_active_isa())
+	{
+		case moo_isa_avx512:
+			kernel = &r2_kernel_avx512;
+			break;
+		case moo_isa_avx2:
+			kernel = &r2_kernel_avx2;
+			break;
+		default:
+			break;
+	}
+#endif
+
+	// Distances to the ideal point, objective by objective
+	D = new_vector_double((size_t)vlen*len);
+	for (i = 0; i < len; i++)
+		for (k = 0; k < vlen; k++)
+			D[(size_t)k*len + i] = fabs(ideal[k] - frontview_at(front, i, k));
+
+	// Weights in blocks, lane by lane, the last block padded with null weights
+	nblocks = (weights->len + R2_WBLOCK - 1) / R2_WBLOCK;
+	Wp = new_vector_double((size_t)nblocks*vlen*R2_WBLOCK);
+	mins = new_vector_double((size_t)nblocks*R2_WBLOCK);
+	for (w = 0; w < nblocks*R2_WBLOCK; w++)
+	{
+		mins[w] = DBL_MAX;
+		if (w >= weights->len)
+			continue;
+		for (k = 0; k < vlen; k++)
+			Wp[((size_t)(w / R2_WBLOCK)*vlen + k)*R2_WBLOCK + w % R2_WBLOCK] =
+					frontview_at(weights, w, k);
+	}
+
+	if (nthreads > nblocks)
+		nthreads = nblocks;
+	if (nthreads < 1)
+		nthreads = 1;
+	tasks = checked_malloc(sizeof(r2_task)*nthreads);
+	threads = checked_malloc(sizeof(pthread_t)*nthreads);
+	for (t = 0; t < nthreads; t++)
+	{
+		tasks[t].D = D;
+		tasks[t].len = len;
+		tasks[t].vlen = vlen;
+		tasks[t].Wp = Wp;
+		tasks[t].mins = mins;
+		tasks[t].b0 = (int)((long)nblocks*t / nthreads);
+		tasks[t].b1 = (int)((long)nblocks*(t + 1) / nthreads);
+		tasks[t].kernel = kernel;
+	}
+	for (t = 1; t < nthreads; t++)
+	{
+		if (pthread_create(&threads[t], NULL, &r2_worker, &tasks[t]))
+		{
+			perror("MOOUtils: Error creating worker thread");
+			exit(EXIT_FAILURE);
+		}
+	}
+	r2_worker(&tasks[0]);
+	for (t = 1; t < nthreads; t++)
+		pthread_join(threads[t], NULL);
+
+	// Accumulated in the order of the weights, whatever the number of threads
+	sum = 0;
+	for (l = 0; l < weights->len; l++)
+		sum += mins[l];
+
+	free(tasks);
+	free(threads);
+	free_vector(D);
+	free_vector(Wp);
+	free_vector(mins);
+	return sum / weights->len;
+}
+
+double r2_indicator(double **front, int frontlen, int vlen, double **weights,
+		int nweights, const double *ideal)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t w = frontview_matrix(weights, nweights, vlen);
+	return r2_indicator_view(&f, &w, ideal, 1);
+}
@@ -0,0 +1,403 @@
+/*
+ * reduce.c
+ *
+ * Reference front reduction. The farthest-point selection keeps the vectors grouped
+ * by representative, along with the radius of every group. By the triangle inequality,
+ * a new representative at distance D from an old one can only take over the vectors of
+ * the old one's group that are farther than D/2 from it, so most groups are skipped
+ * without looking at their vectors.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "reduce.h"
+
+/* Distances checked against the triangle inequality bounds are computed in a different
+ * way than the bounds, so groups and vectors are only skipped with some margin */
+#define REDUCE_SLACK (1 - 1e-12)
+
+// Bisection steps when searching the grid's cell size
+#define GRID_STEPS 32
+
+static inline double dist_between(const frontview_t *front, int a, int b,
+		const double *scale)
+{
+	return strided_squared_dist(frontview_row(front, a), front->cstride,
+			frontview_row(front, b), front->cstride, front->vlen, scale);
+}
+
+/* Positions of the vectors with the minimum and the maximum value of every objective
+ * (the first ones, in case of ties) */
+static void bound_vectors(const frontview_t *front, int *out)
+{
+	int i, k, lo, hi;
+	double v;
+
+	for (k = 0; k < front->vlen; k++)
+	{
+		lo = hi = 0;
+		for (i = 1; i < front->len; i++)
+		{
+			v = frontview_at(front, i, k);
+			if (v < frontview_at(front, lo, k))
+				lo = i;
+			if (v > frontview_at(front, hi, k))
+				hi = i;
+		}
+		out[2*k] = lo;
+		out[2*k+1] = hi;
+	}
+}
+
+typedef struct
+{
+	const frontview_t *front;
+	const double *scale;
+	int *selected;
+	int count;
+	double *mind;     /* squared distance from every vector to its representative */
+	int *owner;       /* group of every vector */
+	int *next;        /* next vector in the same group, -1 at the end */
+	int *head;        /* first vector of every group */
+	int *far;         /* vector of every group farthest from its representative */
+	double *rad;      /* squared radius of every group */
+}fp_state;
+
+static inline void group_push(fp_state *F, int g, int i)
+{
+	F->owner[i] = g;
+	F->next[i] = F->head[g];
+	F->head[g] = i;
+	if (F->mind[i] > F->rad[g] || F->far[g] < 0)
+	{
+		F->rad[g] = F->mind[i];
+		F->far[g] = i;
+	}
+}
+
+static void add_representative(fp_state *F, int c)
+{
+	int a, i, nexti, m = F->count++;
+	double D, d;
+
+	F->selected[m] = c;
+	F->head[m] = -1;
+	F->far[m] = -1;
+	F->rad[m] = 0;
+
+	if (m == 0)
+	{
+		for (i = F->front->len - 1; i >= 0; i--)
+		{
+			F->mind[i] = dist_between(F->front, i, c, F->scale);
+			group_push(F, 0, i);
+		}
+		return;
+	}
+
+	for (a = 0; a < m; a++)
+	{
+		D = dist_between(F->front, F->selected[a], c, F->scale);
+		// No vector of the group is farther than D/2 from its representative
+		if (D*REDUCE_SLACK >= 4*F->rad[a])
+			continue;
+
+		i = F->head[a];
+		F->head[a] = -1;
+		F->far[a] = -1;
+		F->rad[a] = 0;
+		for (; i >= 0; i = nexti)
+		{
+			nexti = F->next[i];
+			if (4*F->mind[i] > D*REDUCE_SLACK)
+			{
+				d = dist_between(F->front, i, c, F->scale);
+				if (d < F->mind[i])
+				{
+					F->mind[i] = d;
+					group_push(F, m, i);
+					continue;
+				}
+			}
+			group_push(F, a, i);
+		}
+	}
+}
+
+int reduce_farthest_point_view(const frontview_t *front, const double *scale, int k,
+		double tol, int *selected, int *assign, double *radius)
+{
+	int i, g, best, n = front->len;
+	int bounds[2*front->vlen];
+	double maxrad;
+	fp_state F;
+
+	if (n == 0 || k <= 0)
+	{
+		if (radius)
+			*radius = 0;
+		return 0;
+	}
+
+	F.front = front;
+	F.scale = scale;
+	F.selected = selected;
+	F.count = 0;
+	F.mind = new_vector_double(n);
+	F.owner = new_vector_int(n);
+	F.next = new_vector_int(n);
+	F.head = new_vector_int(k);
+	F.far = new_vector_int(k);
+	F.rad = new_vector_double(k);
+
+	// The bound-defining vectors go first (skipping copies of the ones already in)
+	bound_vectors(front, bounds);
+	for (i = 0; i < 2*front->vlen && F.count < k; i++)
+		if (F.count == 0 || F.mind[bounds[i]] > 0)
+			add_representative(&F, bounds[i]);
+
+	for (;;)
+	{
+		best = 0;
+		for (g = 1; g < F.count; g++)
+			if (F.rad[g] > F.rad[best])
+				best = g;
+		maxrad = F.rad[best];
+		if (F.count >= k || maxrad == 0 || maxrad <= tol*tol)
+			break;
+		add_representative(&F, F.far[best]);
+	}
+
+	if (assign)
+		for (i = 0; i < n; i++)
+			assign[i] = selected[F.owner[i]];
+	if (radius)
+		*radius = sqrt(maxrad);
+
+	free_vector(F.mind);
+	free_vector(F.owner);
+	free_vector(F.next);
+	free_vector(F.head);
+	free_vector(F.far);
+	free_vector(F.rad);
+	return F.count;
+}
+
+typedef struct
+{
+	const int64_t *cell;
+	int vlen;
+	int index;
+}cell_entry;
+
+static int cell_compare(const void *_a, const void *_b)
+{
+	int k;
+	const cell_entry *a = (const cell_entry*)_a;
+	const cell_entry *b = (const cell_entry*)_b;
+
+	for (k = 0; k < a->vlen; k++)
+	{
+		if (a->cell[k] < b->cell[k])
+			return -1;
+		if (a->cell[k] > b->cell[k])
+			return 1;
+	}
+	return (a->index > b->index) - (a->index < b->index);
+}
+
+/* Grid coreset with cells of side h. Fills reps (room for len + 2*vlen) and, if not
+ * NULL, assign, and returns the number of representatives. */
+static int grid_reduce(const frontview_t *front, const double *scale, const double *min,
+		double h, const int *bounds, int64_t *cells, cell_entry *entries, char *is_rep,
+		int *reps, int *assign)
+{
+	int i, j, g, k, best, count, n = front->len, vlen = front->vlen;
+	double s, u, c, d, bestd;
+
+	for (i = 0; i < n; i++)
+	{
+		for (k = 0; k < vlen; k++)
+		{
+			s = scale ? scale[k] : 1;
+			cells[(size_t)i*vlen + k] = (int64_t)floor((frontview_at(front, i, k) - min[k])*s/h);
+		}
+		entries[i].cell = cells + (size_t)i*vlen;
+		entries[i].vlen = vlen;
+		entries[i].index = i;
+		is_rep[i] = 0;
+	}
+	qsort(entries, n, sizeof(cell_entry), &cell_compare);
+
+	count = 0;
+	for (g = 0; g < n; g = j)
+	{
+		// Vectors in the same cell are contiguous; keep the closest one to the center
+		best = entries[g].index;
+		bestd = DBL_MAX;
+		for (j = g; j < n; j++)
+		{
+			for (k = 0; k < vlen; k++)
+				if (entries[j].cell[k] != entries[g].cell[k])
+					break;
+			if (k < vlen)
+				break;
+			i = entries[j].index;
+			d = 0;
+			for (k = 0; k < vlen; k++)
+			{
+				s = scale ? scale[k] : 1;
+				u = (frontview_at(front, i, k) - min[k])*s;
+				c = (entries[j].cell[k] + 0.5)*h;
+				d += (u - c)*(u - c);
+			}
+			if (d < bestd)
+			{
+				bestd = d;
+				best = i;
+			}
+		}
+		reps[count++] = best;
+		is_rep[best] = 1;
+		if (assign)
+			for (i = g; i < j; i++)
+				assign[entries[i].index] = best;
+	}
+
+	// Keep the bounds of the front
+	for (k = 0; k < 2*vlen; k++)
+	{
+		if (is_rep[bounds[k]])
+			continue;
+		reps[count++] = bounds[k];
+		is_rep[bounds[k]] = 1;
+		if (assign)
+			assign[bounds[k]] = bounds[k];
+	}
+	return count;
+}
+
+int reduce_grid_view(const frontview_t *front, const double *scale, int k,
+		int *selected, int *assign, double *radius)
+{
+	int i, step, count, n = front->len, vlen = front->vlen;
+	int bounds[2*vlen];
+	double lo, hi, mid, span, d, maxd;
+	double min[vlen], max[vlen];
+	int64_t *cells;
+	cell_entry *entries;
+	char *is_rep;
+	int *reps, *owners;
+
+	if (n == 0 || k <= 0)
+	{
+		if (radius)
+			*radius = 0;
+		return 0;
+	}
+
+	cells = malloc(sizeof(int64_t)*n*vlen);
+	entries = malloc(sizeof(cell_entry)*n);
+	is_rep = malloc(n);
+	reps = new_vector_int(n + 2*vlen);
+	if (!cells || !entries || !is_rep)
+	{
+		perror("MOOUtils: Out of memory when reducing front");
+		exit(EXIT_FAILURE);
+	}
+
+	view_bounds(front, min, max);
+	bound_vectors(front, bounds);
+
+	/* A cell as large as the whole (scaled) front gives the fewest representatives.
+	 * If even that is too many, the farthest-point selection is used instead. */
+	span = 0;
+	for (i = 0; i < vlen; i++)
+		if ((max[i] - min[i])*(scale ? scale[i] : 1) > span)
+			span = (max[i] - min[i])*(scale ? scale[i] : 1);
+	hi = (span > 0) ? 2*span : 1;
+	count = grid_reduce(front, scale, min, hi, bounds, cells, entries, is_rep, reps, NULL);
+	if (count > k)
+	{
+		free(cells);
+		free(entries);
+		free(is_rep);
+		free_vector(reps);
+		return reduce_farthest_point_view(front, scale, k, 0, selected, assign, radius);
+	}
+
+	// Smallest cell size (on a logarithmic scale) giving at most k representatives
+	lo = hi*1e-12;
+	for (step = 0; step < GRID_STEPS; step++)
+	{
+		mid = sqrt(lo*hi);
+		if (grid_reduce(front, scale, min, mid, bounds, cells, entries, is_rep, reps,
+				NULL) <= k)
+			hi = mid;
+		else
+			lo = mid;
+	}
+	owners = assign ? assign : new_vector_int(n);
+	count = grid_reduce(front, scale, min, hi, bounds, cells, entries, is_rep, reps,
+			owners);
+	for (i = 0; i < count; i++)
+		selected[i] = reps[i];
+
+	if (radius)
+	{
+		maxd = 0;
+		for (i = 0; i < n; i++)
+		{
+			d = dist_between(front, i, owners[i], scale);
+			maxd = (d > maxd) ? d : maxd;
+		}
+		*radius = sqrt(maxd);
+	}
+	if (!assign)
+		free_vector(owners);
+
+	free(cells);
+	free(entries);
+	free(is_rep);
+	free_vector(reps);
+	return count;
+}
+
+int reduce_front(double **front, int frontlen, int vlen, int k, int *selected,
+		double *radius)
+{
+	int count;
+	double *scale;
+	frontview_t view = frontview_matrix(front, frontlen, vlen);
+
+	scale = view_norm_scale(&view);
+	count = reduce_farthest_point_view(&view, scale, k, 0, selected, NULL, radius);
+	free_vector(scale);
+	return count;
+}
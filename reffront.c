@@ -0,0 +1,431 @@
+/*
+ * reffront.c
+ *
+ * Prepared reference fronts. A prepared front is a set of flat arrays, so saving it
+ * is just writing them one after the other behind a small header, and loading it is
+ * mapping the file and pointing the fields of the structure into the mapping.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "blockdist.h"
+#include "biobj.h"
+#include "kdtree.h"
+#include "nearest.h"
+#include "reffront.h"
+
+#define REFFRONT_MAGIC "MOOREF\0"
+#define REFFRONT_BYTEORDER 0x01020304u
+#define REFFRONT_SIZES ((uint32_t)(sizeof(double) | sizeof(int) << 8 | \
+		sizeof(kdnode_t) << 16))
+
+/* File header. It's followed by min, max, scale, the stored vectors and the kd-tree
+ * nodes (all of them 8-byte aligned), and then by index, order and extremes. */
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteorder;
+	uint32_t sizes;
+	int32_t len;
+	int32_t vlen;
+	int32_t nnodes;
+	int32_t staircase;
+	int32_t reserved;
+	uint64_t filelen;
+}reffront_header;
+
+static reffront_t *new_reffront(int len, int vlen)
+{
+	reffront_t *R = malloc(sizeof(reffront_t));
+	if (!R)
+	{
+		perror("MOOUtils: Out of memory when preparing reference front");
+		exit(EXIT_FAILURE);
+	}
+	memset(R, 0, sizeof(reffront_t));
+	R->len = len;
+	R->vlen = vlen;
+	return R;
+}
+
+// Size of the file holding a prepared front
+static uint64_t file_length(int len, int vlen, int nnodes)
+{
+	return sizeof(reffront_header) + sizeof(double)*(3*(uint64_t)vlen +
+			(uint64_t)len*vlen) + sizeof(kdnode_t)*(uint64_t)nnodes +
+			sizeof(int)*(2*(uint64_t)len + vlen);
+}
+
+/* Points the search structures to the stored vectors. The tree nodes (if any) must
+ * be in place already. */
+static void setup_index(reffront_t *R, int staircase)
+{
+	R->view = frontview_rowmajor(R->view.base, R->len, R->vlen);
+
+	R->stair.len = (R->vlen == 2) ? R->len : 0;
+	R->stair.staircase = staircase;
+	R->stair.sx = R->scale[0];
+	R->stair.sy = (R->vlen > 1) ? R->scale[1] : 1;
+	R->stair.xy = R->view.base;
+	R->stair.index = NULL;
+
+	R->tree.len = R->len;
+	R->tree.vlen = R->vlen;
+	R->tree.pts = R->view.base;
+	R->tree.index = NULL;
+	R->tree.scale = R->scale;
+}
+
+reffront_t *reffront_prepare(const frontview_t *truefront)
+{
+	int i, k, len = truefront->len, vlen = truefront->vlen;
+	int staircase;
+	int *inv;
+	double *pts;
+	kdtree_t *T;
+	reffront_t *R;
+
+	R = new_reffront(len, vlen);
+	R->min = new_vector_double(vlen);
+	R->max = new_vector_double(vlen);
+	view_bounds(truefront, R->min, R->max);
+	R->scale = view_norm_scale(truefront);
+	R->extremes = new_vector_int(vlen);
+	view_extreme_sols(truefront, R->extremes);
+	R->order = new_vector_int(len + 1);
+
+	if (vlen != 2 && vlen < BLOCKDIST_MIN_VLEN)
+	{
+		// The tree already keeps a copy of the vectors in its own order
+		T = kdtree_build(truefront, R->scale);
+		pts = T->pts;
+		R->index = T->index;
+		R->tree.nodes = T->nodes;
+		R->tree.nnodes = T->nnodes;
+		free_vector(T->scale);
+		free(T);
+	}
+	else
+	{
+		R->index = new_vector_int(len + 1);
+		if (vlen == 2)
+			lexicographical_order(truefront, R->index);
+		else
+			for (i = 0; i < len; i++)
+				R->index[i] = i;
+		pts = new_vector_double((size_t)len*vlen + 1);
+		for (i = 0; i < len; i++)
+			for (k = 0; k < vlen; k++)
+				pts[(size_t)i*vlen + k] = frontview_at(truefront, R->index[i], k);
+	}
+	R->view.base = pts;
+
+	staircase = 1;
+	for (i = 1; vlen == 2 && i < len; i++)
+		if (pts[2*i+1] > pts[2*i-1])
+			staircase = 0;
+	setup_index(R, staircase);
+
+	// Positions in the original front are turned into positions in the stored one
+	inv = new_vector_int(len + 1);
+	for (i = 0; i < len; i++)
+		inv[R->index[i]] = i;
+	for (k = 0; k < vlen; k++)
+		R->extremes[k] = inv[R->extremes[k]];
+	free_vector(inv);
+
+	lexicographical_order(&R->view, R->order);
+	return R;
+}
+
+static void write_section(FILE *f, const void *data, size_t size)
+{
+	if (size && fwrite(data, 1, size, f) != size)
+	{
+		perror("MOOUtils: Error writing reference front file");
+		exit(EXIT_FAILURE);
+	}
+}
+
+void reffront_save(const reffront_t *R, const char *path)
+{
+	FILE *f;
+	reffront_header h;
+
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, REFFRONT_MAGIC, sizeof(h.magic));
+	h.version = REFFRONT_VERSION;
+	h.byteorder = REFFRONT_BYTEORDER;
+	h.sizes = REFFRONT_SIZES;
+	h.len = R->len;
+	h.vlen = R->vlen;
+	h.nnodes = R->tree.nnodes;
+	h.staircase = R->stair.staircase;
+	h.filelen = file_length(R->len, R->vlen, R->tree.nnodes);
+
+	f = fopen(path, "wb");
+	if (!f)
+	{
+		perror("MOOUtils: Error opening reference front file");
+		exit(EXIT_FAILURE);
+	}
+	write_section(f, &h, sizeof(h));
+	write_section(f, R->min, sizeof(double)*R->vlen);
+	write_section(f, R->max, sizeof(double)*R->vlen);
+	write_section(f, R->scale, sizeof(double)*R->vlen);
+	write_section(f, R->view.base, sizeof(double)*R->len*R->vlen);
+	write_section(f, R->tree.nodes, sizeof(kdnode_t)*R->tree.nnodes);
+	write_section(f, R->index, sizeof(int)*R->len);
+	write_section(f, R->order, sizeof(int)*R->len);
+	write_section(f, R->extremes, sizeof(int)*R->vlen);
+	if (fclose(f))
+	{
+		perror("MOOUtils: Error writing reference front file");
+		exit(EXIT_FAILURE);
+	}
+}
+
+static int valid_positions(const int *pos, int n, int len)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		if (pos[i] < 0 || pos[i] >= len)
+			return 0;
+	return 1;
+}
+
+/* Checks that every position read from a mapped file is within its array, so a corrupt
+ * file can't make the searches read outside the mapping. Inner nodes of the kd-tree
+ * must split their range at the middle between two later nodes, as kdtree_build does,
+ * which also bounds the depth of the searches. */
+static int valid_mapping(const reffront_t *R)
+{
+	int n, mid;
+	const kdnode_t *N, *L, *H;
+
+	if (R->stair.staircase != 0 && R->stair.staircase != 1)
+		return 0;
+	if (R->vlen != 2 && R->vlen < BLOCKDIST_MIN_VLEN && R->len > 0 && R->tree.nnodes == 0)
+		return 0;
+	if (R->tree.nnodes > 0 && (R->tree.nodes[0].lo != 0 || R->tree.nodes[0].hi != R->len))
+		return 0;
+	for (n = 0; n < R->tree.nnodes; n++)
+	{
+		N = &R->tree.nodes[n];
+		if (N->lo < 0 || N->lo > N->hi || N->hi > R->len || N->dim < 0 || N->dim >= R->vlen)
+			return 0;
+		if (N->left == -1 && N->right == -1)
+			continue;
+		if (N->left <= n || N->left >= R->tree.nnodes || N->right <= n ||
+				N->right >= R->tree.nnodes)
+			return 0;
+		L = &R->tree.nodes[N->left];
+		H = &R->tree.nodes[N->right];
+		mid = N->lo + (N->hi - N->lo)/2;
+		if (L->lo != N->lo || L->hi != mid || H->lo != mid || H->hi != N->hi)
+			return 0;
+	}
+	if (!valid_positions(R->index, R->len, R->len) ||
+			!valid_positions(R->order, R->len, R->len))
+		return 0;
+	return R->len == 0 || valid_positions(R->extremes, R->vlen, R->len);
+}
+
+reffront_t *reffront_map(const char *path)
+{
+	int fd, err;
+	struct stat st;
+	char *map, *p;
+	reffront_header h;
+	reffront_t *R;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	if (fstat(fd, &st))
+	{
+		err = errno;
+		close(fd);
+		errno = err;
+		return NULL;
+	}
+	if ((size_t)st.st_size < sizeof(h))
+	{
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		errno = err;
+		return NULL;
+	}
+
+	memcpy(&h, map, sizeof(h));
+	if (memcmp(h.magic, REFFRONT_MAGIC, sizeof(h.magic)) || h.version != REFFRONT_VERSION ||
+			h.byteorder != REFFRONT_BYTEORDER || h.sizes != REFFRONT_SIZES ||
+			h.len < 0 || h.vlen <= 0 || h.nnodes < 0 ||
+			h.filelen != (uint64_t)st.st_size ||
+			h.filelen != file_length(h.len, h.vlen, h.nnodes))
+	{
+		munmap(map, st.st_size);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	// The mapping is read-only, and so is every use of the prepared front
+	R = new_reffront(h.len, h.vlen);
+	R->map = map;
+	R->maplen = st.st_size;
+	p = map + sizeof(h);
+	R->min = (double*)p;
+	p += sizeof(double)*h.vlen;
+	R->max = (double*)p;
+	p += sizeof(double)*h.vlen;
+	R->scale = (double*)p;
+	p += sizeof(double)*h.vlen;
+	R->view.base = (double*)p;
+	p += sizeof(double)*h.len*h.vlen;
+	R->tree.nodes = (kdnode_t*)p;
+	R->tree.nnodes = h.nnodes;
+	p += sizeof(kdnode_t)*h.nnodes;
+	R->index = (int*)p;
+	p += sizeof(int)*h.len;
+	R->order = (int*)p;
+	p += sizeof(int)*h.len;
+	R->extremes = (int*)p;
+
+	setup_index(R, h.staircase);
+	if (!valid_mapping(R))
+	{
+		free_reffront(R);
+		errno = EINVAL;
+		return NULL;
+	}
+	return R;
+}
+
+reffront_t *reffront_load(const char *path)
+{
+	reffront_t *R = reffront_map(path);
+	if (!R)
+	{
+		perror("MOOUtils: Error loading reference front file");
+		exit(EXIT_FAILURE);
+	}
+	return R;
+}
+
+void reffront_nearest_squared_dists(const reffront_t *R, const frontview_t *X, int flags,
+		double *dists, int *nearest)
+{
+	int i, idx;
+	int distinct = (flags & NEAREST_DISTINCT) != 0;
+
+	if (R->vlen >= BLOCKDIST_MIN_VLEN)
+	{
+		block_min_squared_dists(X, &R->view, R->scale,
+				BLOCKDIST_EXACT | (distinct ? BLOCKDIST_DISTINCT : 0), dists, nearest);
+		return;
+	}
+	for (i = 0; i < X->len; i++)
+	{
+		if (R->vlen == 2)
+			dists[i] = staircase_nearest(&R->stair, frontview_at(X, i, 0),
+					frontview_at(X, i, 1), distinct, &idx);
+		else
+			dists[i] = kdtree_nearest(&R->tree, frontview_row(X, i), X->cstride, distinct,
+					&idx);
+		if (nearest)
+			nearest[i] = idx;
+	}
+}
+
+void reffront_nearest_squared_dists_approx(const reffront_t *R, const frontview_t *X,
+		double eps, double *dists, double *lower)
+{
+	int i;
+
+	if (R->vlen >= BLOCKDIST_MIN_VLEN)
+	{
+		block_min_squared_dists(X, &R->view, R->scale, BLOCKDIST_EXACT, dists, NULL);
+		for (i = 0; i < X->len; i++)
+			lower[i] = dists[i];
+		return;
+	}
+	for (i = 0; i < X->len; i++)
+	{
+		if (R->vlen == 2)
+			dists[i] = staircase_nearest_approx(&R->stair, frontview_at(X, i, 0),
+					frontview_at(X, i, 1), eps, &lower[i], NULL);
+		else
+			dists[i] = kdtree_nearest_approx(&R->tree, frontview_row(X, i), X->cstride, eps,
+					&lower[i], NULL);
+	}
+}
+
+void reffront_original_order(const reffront_t *R, const double *values, double *out)
+{
+	int i;
+
+	for (i = 0; i < R->len; i++)
+		out[R->index[i]] = values[i];
+}
+
+void free_reffront(reffront_t *R)
+{
+	if (!R)
+		return;
+	if (R->map)
+	{
+		munmap(R->map, R->maplen);
+	}
+	else
+	{
+		free_vector(R->min);
+		free_vector(R->max);
+		free_vector(R->scale);
+		free_vector(R->view.base);
+		free(R->tree.nodes);
+		free_vector(R->index);
+		free_vector(R->order);
+		free_vector(R->extremes);
+	}
+	free(R);
+}
@@ -0,0 +1,471 @@
+/*
+ * rescache.c
+ *
+ * Cache of indicator results. The cache is an array of sets of RESCACHE_WAYS entries,
+ * preceded by a header with a clock that is advanced on every access and stamped on
+ * the entries used, so the least recently used entry of a set is the one with the
+ * lowest stamp. The same layout is used in memory and in a file, which is mapped as
+ * it is; file-backed caches take a lock on the file around every access, besides the
+ * mutex that serializes the threads of the process (file locks don't).
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "frontview.h"
+#include "reffront.h"
+#include "suite.h"
+#include "rescache.h"
+
+#define RESCACHE_MAGIC "MOOCACH"
+#define RESCACHE_BYTEORDER 0x01020304u
+
+// Number of indicators in indicator_results_t, in the order of their INDICATOR_* flags
+#define RESCACHE_NVALUES 7
+
+/* File header, followed by the entries */
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteorder;
+	uint32_t entrysize;
+	uint32_t ways;
+	uint32_t nsets;
+	uint32_t reserved;
+	uint64_t clock;      /* stamp of the last access */
+	uint64_t filelen;
+	uint64_t pad[2];
+}rescache_hdr;
+
+typedef struct
+{
+	uint64_t fkey;       /* hash of the set */
+	uint64_t tkey;       /* hash of the true front */
+	uint64_t stamp;      /* last use, 0 if the entry is free */
+	int32_t flen;
+	int32_t tlen;
+	int32_t vlen;
+	uint32_t masks;      /* indicators requested, and computed ones in the next byte */
+	double values[RESCACHE_NVALUES];
+}rescache_entry;
+
+struct rescache
+{
+	rescache_hdr *hdr;
+	rescache_entry *entries;
+	size_t size;         /* bytes of the header and the entries */
+	int fd;              /* -1 for caches in memory */
+	pthread_mutex_t lock;
+};
+
+/* Key of an evaluation */
+typedef struct
+{
+	uint64_t fkey, tkey;
+	int32_t flen, tlen, vlen;
+}rescache_key;
+
+/* xxHash64 primes */
+#define PRIME1 11400714785074694791ULL
+#define PRIME2 14029467366897019727ULL
+#define PRIME3 1609587929392839161ULL
+#define PRIME4 9650029242287828579ULL
+#define PRIME5 2870177450012600261ULL
+
+static inline uint64_t rotl(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hash_round(uint64_t acc, uint64_t v)
+{
+	acc += v * PRIME2;
+	return rotl(acc, 31) * PRIME1;
+}
+
+static inline uint64_t value_bits(double v)
+{
+	uint64_t bits;
+
+	// Adding 0 turns -0 into 0, so that equal values hash the same
+	v += 0.0;
+	memcpy(&bits, &v, sizeof(bits));
+	return bits;
+}
+
+/* Adds n values, cstride doubles apart, to the lanes. pos is the number of values
+ * added so far, which tells the lane of each one. */
+static void hash_values(uint64_t *lanes, uint64_t *pos, const double *p, ptrdiff_t cs,
+		int n)
+{
+	int i = 0;
+	uint64_t l0, l1, l2, l3;
+
+	for (; i < n && (*pos & 3); i++, (*pos)++)
+		lanes[*pos & 3] = hash_round(lanes[*pos & 3], value_bits(p[i*cs]));
+	l0 = lanes[0];
+	l1 = lanes[1];
+	l2 = lanes[2];
+	l3 = lanes[3];
+	for (; i + 4 <= n; i += 4)
+	{
+		l0 = hash_round(l0, value_bits(p[i*cs]));
+		l1 = hash_round(l1, value_bits(p[(i + 1)*cs]));
+		l2 = hash_round(l2, value_bits(p[(i + 2)*cs]));
+		l3 = hash_round(l3, value_bits(p[(i + 3)*cs]));
+	}
+	lanes[0] = l0;
+	lanes[1] = l1;
+	lanes[2] = l2;
+	lanes[3] = l3;
+	*pos += i & ~3;
+	for (; i < n; i++, (*pos)++)
+		lanes[*pos & 3] = hash_round(lanes[*pos & 3], value_bits(p[i*cs]));
+}
+
+uint64_t front_hash(const frontview_t *set)
+{
+	int i, k;
+	uint64_t h, pos, seed, lanes[4];
+
+	seed = (uint64_t)set->len * PRIME5 + (uint64_t)set->vlen;
+	lanes[0] = seed + PRIME1 + PRIME2;
+	lanes[1] = seed + PRIME2;
+	lanes[2] = seed;
+	lanes[3] = seed - PRIME1;
+	pos = 0;
+
+	// Contiguous row-major buffers are hashed in one go, anything else a vector at a time
+	if (!set->rows && set->cstride == 1 && set->rstride == set->vlen)
+		hash_values(lanes, &pos, set->base, 1, set->len*set->vlen);
+	else
+		for (i = 0; i < set->len; i++)
+			hash_values(lanes, &pos, frontview_row(set, i), set->cstride, set->vlen);
+
+	h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+	for (k = 0; k < 4; k++)
+	{
+		h ^= hash_round(0, lanes[k]);
+		h = h * PRIME1 + PRIME4;
+	}
+	h += pos * sizeof(double);
+	h ^= h >> 33;
+	h *= PRIME2;
+	h ^= h >> 29;
+	h *= PRIME3;
+	h ^= h >> 32;
+	return h;
+}
+
+/* Locking */
+
+static void cache_lock(rescache_t *C)
+{
+	pthread_mutex_lock(&C->lock);
+	if (C->fd >= 0)
+		while (flock(C->fd, LOCK_EX) && errno == EINTR)
+			;
+}
+
+static void cache_unlock(rescache_t *C)
+{
+	if (C->fd >= 0)
+		flock(C->fd, LOCK_UN);
+	pthread_mutex_unlock(&C->lock);
+}
+
+/* Entries */
+
+static inline int key_matches(const rescache_entry *E, const rescache_key *K)
+{
+	return E->stamp && E->fkey == K->fkey && E->tkey == K->tkey && E->flen == K->flen &&
+			E->tlen == K->tlen && E->vlen == K->vlen;
+}
+
+static rescache_entry *first_way(const rescache_t *C, const rescache_key *K)
+{
+	uint64_t h = (K->fkey ^ rotl(K->tkey, 29)) * PRIME1;
+	return C->entries + (size_t)((h >> 32) % C->hdr->nsets)*C->hdr->ways;
+}
+
+/* Finds the entry of a key, NULL if there's none. Must be called with the cache
+ * locked. */
+static rescache_entry *find_entry(rescache_t *C, const rescache_key *K)
+{
+	uint32_t w;
+	rescache_entry *E = first_way(C, K);
+
+	for (w = 0; w < C->hdr->ways; w++)
+		if (key_matches(&E[w], K))
+			return &E[w];
+	return NULL;
+}
+
+/* Finds the entry of a key, or else takes the least recently used one of its set
+ * (free ones first). Must be called with the cache locked. */
+static rescache_entry *claim_entry(rescache_t *C, const rescache_key *K)
+{
+	uint32_t w;
+	rescache_entry *E = first_way(C, K), *victim = E;
+
+	for (w = 0; w < C->hdr->ways; w++)
+	{
+		if (key_matches(&E[w], K))
+			return &E[w];
+		if (E[w].stamp < victim->stamp)
+			victim = &E[w];
+	}
+	memset(victim, 0, sizeof(rescache_entry));
+	victim->fkey = K->fkey;
+	victim->tkey = K->tkey;
+	victim->flen = K->flen;
+	victim->tlen = K->tlen;
+	victim->vlen = K->vlen;
+	return victim;
+}
+
+static inline double *result_value(indicator_results_t *R, int i)
+{
+	double *values[RESCACHE_NVALUES] = {&R->gd, &R->igd, &R->spread, &R->gspread,
+			&R->gspread_orig, &R->epsilon_add, &R->epsilon_mul};
+	return values[i];
+}
+
+/* Shared body of rescache_suite_view and rescache_suite_ref. R is the prepared true
+ * front, or NULL. */
+static int cached_suite(rescache_t *C, const frontview_t *front,
+		const frontview_t *truefront, const reffront_t *R, int mask,
+		indicator_results_t *results)
+{
+	int i, have, computed, need;
+	rescache_key K;
+	rescache_entry *E;
+	indicator_results_t fresh;
+
+	mask &= INDICATOR_ALL;
+	K.fkey = front_hash(front);
+	K.tkey = front_hash(truefront);
+	K.flen = front->len;
+	K.tlen = truefront->len;
+	K.vlen = front->vlen;
+
+	// What the entry has is copied out, and the rest is computed without the lock
+	have = computed = 0;
+	cache_lock(C);
+	if ((E = find_entry(C, &K)))
+	{
+		E->stamp = ++C->hdr->clock;
+		have = E->masks & 0xff;
+		computed = (E->masks >> 8) & 0xff;
+		for (i = 0; i < RESCACHE_NVALUES; i++)
+			if (computed & (1 << i))
+				*result_value(results, i) = E->values[i];
+	}
+	cache_unlock(C);
+
+	need = mask & ~have;
+	if (need)
+	{
+		if (R)
+			indicator_suite_ref(front, R, need, &fresh);
+		else
+			indicator_suite_view(front, truefront, need, &fresh);
+		for (i = 0; i < RESCACHE_NVALUES; i++)
+			if (fresh.computed & (1 << i))
+				*result_value(results, i) = *result_value(&fresh, i);
+		have |= need;
+		computed |= fresh.computed;
+
+		/* The entry may have been evicted or extended meanwhile, so everything known
+		 * is merged into whichever entry the key gets now */
+		cache_lock(C);
+		E = claim_entry(C, &K);
+		E->stamp = ++C->hdr->clock;
+		for (i = 0; i < RESCACHE_NVALUES; i++)
+			if (computed & (1 << i))
+				E->values[i] = *result_value(results, i);
+		E->masks = (E->masks & 0xffff) | have | computed << 8;
+		cache_unlock(C);
+	}
+	results->computed = computed & mask;
+	return !need;
+}
+
+int rescache_suite_view(rescache_t *C, const frontview_t *front,
+		const frontview_t *truefront, int mask, indicator_results_t *results)
+{
+	return cached_suite(C, front, truefront, NULL, mask, results);
+}
+
+int rescache_suite_ref(rescache_t *C, const frontview_t *front,
+		const reffront_t *truefront, int mask, indicator_results_t *results)
+{
+	return cached_suite(C, front, &truefront->view, truefront, mask, results);
+}
+
+int rescache_suite(rescache_t *C, double **front, int frontlen, double **truefront,
+		int truefrontlen, int vlen, int mask, indicator_results_t *results)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	return rescache_suite_view(C, &f, &t, mask, results);
+}
+
+/* Opening and closing */
+
+static void init_header(rescache_hdr *h, uint32_t nsets, size_t size)
+{
+	memset(h, 0, sizeof(rescache_hdr));
+	memcpy(h->magic, RESCACHE_MAGIC, sizeof(h->magic));
+	h->version = RESCACHE_VERSION;
+	h->byteorder = RESCACHE_BYTEORDER;
+	h->entrysize = sizeof(rescache_entry);
+	h->ways = RESCACHE_WAYS;
+	h->nsets = nsets;
+	h->filelen = size;
+}
+
+/* Maps a cache file, creating it if it's empty. The file is locked meanwhile, so two
+ * processes creating the same file don't step on each other. */
+static int map_file(rescache_t *C, const char *path, uint32_t nsets)
+{
+	int err = 0;
+	struct stat st;
+	rescache_hdr h;
+
+	C->fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (C->fd < 0)
+		return -1;
+	while (flock(C->fd, LOCK_EX) && errno == EINTR)
+		;
+	if (fstat(C->fd, &st))
+		err = errno;
+	else if (st.st_size == 0)
+	{
+		// New file: the entries are zeroed by ftruncate, which makes them free
+		C->size = sizeof(rescache_hdr) + sizeof(rescache_entry)*(size_t)nsets*RESCACHE_WAYS;
+		init_header(&h, nsets, C->size);
+		if (ftruncate(C->fd, C->size))
+			err = errno;
+		else if (pwrite(C->fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h))
+			err = EIO;
+	}
+	else
+	{
+		C->size = st.st_size;
+		if ((size_t)st.st_size < sizeof(h) ||
+				pread(C->fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+				memcmp(h.magic, RESCACHE_MAGIC, sizeof(h.magic)) ||
+				h.version != RESCACHE_VERSION || h.byteorder != RESCACHE_BYTEORDER ||
+				h.entrysize != sizeof(rescache_entry) || h.ways != RESCACHE_WAYS ||
+				h.nsets == 0 || h.filelen != (uint64_t)st.st_size ||
+				h.filelen != sizeof(h) + sizeof(rescache_entry)*(uint64_t)h.nsets*h.ways)
+			err = EINVAL;
+	}
+	if (!err)
+	{
+		C->hdr = mmap(NULL, C->size, PROT_READ | PROT_WRITE, MAP_SHARED, C->fd, 0);
+		if (C->hdr == MAP_FAILED)
+			err = errno;
+	}
+	flock(C->fd, LOCK_UN);
+	if (err)
+	{
+		close(C->fd);
+		errno = err;
+		return -1;
+	}
+	return 0;
+}
+
+rescache_t *rescache_open(const char *path, int capacity)
+{
+	uint32_t nsets;
+	rescache_t *C;
+
+	if (capacity <= 0)
+	{
+		perror("MOOUtils: Invalid option.");
+		exit(EXIT_FAILURE);
+	}
+	C = malloc(sizeof(rescache_t));
+	if (!C)
+	{
+		perror("MOOUtils: Out of memory when opening result cache");
+		exit(EXIT_FAILURE);
+	}
+	nsets = (capacity + RESCACHE_WAYS - 1) / RESCACHE_WAYS;
+
+	if (path)
+	{
+		if (map_file(C, path, nsets))
+		{
+			free(C);
+			return NULL;
+		}
+	}
+	else
+	{
+		C->fd = -1;
+		C->size = sizeof(rescache_hdr) + sizeof(rescache_entry)*(size_t)nsets*RESCACHE_WAYS;
+		C->hdr = calloc(1, C->size);
+		if (!C->hdr)
+		{
+			perror("MOOUtils: Out of memory when opening result cache");
+			exit(EXIT_FAILURE);
+		}
+		init_header(C->hdr, nsets, C->size);
+	}
+	C->entries = (rescache_entry*)(C->hdr + 1);
+	pthread_mutex_init(&C->lock, NULL);
+	return C;
+}
+
+int rescache_capacity(const rescache_t *C)
+{
+	return C->hdr->nsets * C->hdr->ways;
+}
+
+void rescache_close(rescache_t *C)
+{
+	if (!C)
+		return;
+	if (C->fd >= 0)
+	{
+		munmap(C->hdr, C->size);
+		close(C->fd);
+	}
+	else
+		free(C->hdr);
+	pthread_mutex_destroy(&C->lock);
+	free(C);
+}
@@ -0,0 +1,386 @@
+/*
+ * soafront.c
+ *
+ * Columnar fronts. Every kernel loads the same component of several consecutive
+ * vectors into one vector register, so it does the work of that many vectors per
+ * instruction, and keeps a lane per vector of the set. The kernels are generated once
+ * per instruction set variant, with as many lanes as its registers hold, and every
+ * lane does the same operations in the same order as the scalar code they replace, so
+ * the results are the same. Selections are spelled out as masks (see r2.c).
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "cpudispatch.h"
+#include "epsilon.h"
+#include "soafront.h"
+
+// Vectors of B scanned by the epsilon kernel between checks for an early stop
+#define SOAFRONT_CHUNK 256
+
+typedef struct
+{
+	void (*bounds)(const double *col, int stride, double *lo, double *hi);
+	int (*dominance)(const soafront_t *S, const double *x, signed char *out);
+	double (*nearest)(const soafront_t *S, const double *x, ptrdiff_t xs,
+			const double *scale, int *best);
+	double (*epsilon)(const soafront_t *B, int j0, int j1, const double *a,
+			epsilon_t method);
+}soa_kernels;
+
+#define SOA_SELECT(mask_t, sel, a, b) ((__typeof__(a))(((mask_t)(a) & (sel)) | \
+		((mask_t)(b) & ~(sel))))
+
+#define SOA_KERNELS(sfx, target, lanes)                                                \
+typedef double soa_vec##sfx __attribute__((vector_size(lanes*sizeof(double))));        \
+typedef long long soa_mask##sfx __attribute__((vector_size(lanes*sizeof(long long)))); \
+                                                                                       \
+/* Smallest and largest values of a column */                                          \
+static target void bounds##sfx(const double *col, int stride, double *lo, double *hi)  \
+{                                                                                      \
+	int i, l;                                                                          \
+	soa_vec##sfx v, a, b;                                                              \
+	soa_mask##sfx sel;                                                                 \
+                                                                                       \
+	__builtin_memcpy(&a, col, sizeof(a));                                              \
+	b = a;                                                                             \
+	for (i = lanes; i < stride; i += lanes)                                            \
+	{                                                                                  \
+		__builtin_memcpy(&v, col + i, sizeof(v));                                      \
+		sel = (v < a);                                                                 \
+		a = SOA_SELECT(soa_mask##sfx, sel, v, a);                                      \
+		sel = (v > b);                                                                 \
+		b = SOA_SELECT(soa_mask##sfx, sel, v, b);                                      \
+	}                                                                                  \
+	*lo = a[0];                                                                        \
+	*hi = b[0];                                                                        \
+	for (l = 1; l < lanes; l++)                                                        \
+	{                                                                                  \
+		*lo = (a[l] < *lo) ? a[l] : *lo;                                               \
+		*hi = (b[l] > *hi) ? b[l] : *hi;                                               \
+	}                                                                                  \
+}                                                                                      \
+                                                                                       \
+/* Dominance between a vector and every vector of a set: lanes where x is lower or     \
+ * equal in every objective and lower in some, and the other way round */              \
+static target int dominance##sfx(const soafront_t *S, const double *x,                 \
+		signed char *out)                                                              \
+{                                                                                      \
+	int i, k, l, count = 0;                                                            \
+	soa_vec##sfx c, xv;                                                                \
+	soa_mask##sfx le, lt, ge, gt, res;                                                 \
+                                                                                       \
+	for (i = 0; i < S->len; i += lanes)                                                \
+	{                                                                                  \
+		le = ge = (soa_mask##sfx){} - 1;                                               \
+		lt = gt = (soa_mask##sfx){};                                                   \
+		for (k = 0; k < S->vlen; k++)                                                  \
+		{                                                                              \
+			__builtin_memcpy(&c, soafront_column(S, k) + i, sizeof(c));                \
+			xv = (soa_vec##sfx){} + x[k];                                              \
+			le &= (xv <= c);                                                           \
+			lt |= (xv < c);                                                            \
+			ge &= (xv >= c);                                                           \
+			gt |= (xv > c);                                                            \
+		}                                                                              \
+		/* -1 where x dominates, 1 where it's dominated */                             \
+		res = ((ge & gt) & 1) | (le & lt);                                             \
+		for (l = 0; l < lanes && i + l < S->len; l++)                                  \
+		{                                                                              \
+			out[i + l] = (signed char)res[l];                                          \
+			count += (res[l] == 1);                                                    \
+		}                                                                              \
+	}                                                                                  \
+	return count;                                                                      \
+}                                                                                      \
+                                                                                       \
+/* Squared distance from a vector to the nearest vector of a set, and the index of     \
+ * the first one at that distance */                                                   \
+static target double nearest##sfx(const soafront_t *S, const double *x, ptrdiff_t xs,  \
+		const double *scale, int *best)                                                \
+{                                                                                      \
+	int i, k, l;                                                                       \
+	double bestd;                                                                      \
+	soa_vec##sfx c, t, d, m;                                                           \
+	soa_mask##sfx sel, idx, mi, lane;                                                  \
+                                                                                       \
+	for (l = 0; l < lanes; l++)                                                        \
+		lane[l] = l;                                                                   \
+	m = (soa_vec##sfx){} + DBL_MAX;                                                    \
+	mi = (soa_mask##sfx){} - 1;                                                        \
+	for (i = 0; i < S->stride; i += lanes)                                             \
+	{                                                                                  \
+		d = (soa_vec##sfx){};                                                          \
+		for (k = 0; k < S->vlen; k++)                                                  \
+		{                                                                              \
+			__builtin_memcpy(&c, soafront_column(S, k) + i, sizeof(c));                \
+			t = (x[k*xs] - c) * (scale ? scale[k] : 1);                                \
+			d += t * t;                                                                \
+		}                                                                              \
+		sel = (d < m);                                                                 \
+		m = SOA_SELECT(soa_mask##sfx, sel, d, m);                                      \
+		idx = lane + i;                                                                \
+		mi = (idx & sel) | (mi & ~sel);                                                \
+	}                                                                                  \
+	/* Padding copies the last vector, so ties go to the lowest index */               \
+	bestd = m[0];                                                                      \
+	*best = (int)mi[0];                                                                \
+	for (l = 1; l < lanes; l++)                                                        \
+	{                                                                                  \
+		if (m[l] < bestd || (m[l] == bestd && mi[l] < *best))                          \
+		{                                                                              \
+			bestd = m[l];                                                              \
+			*best = (int)mi[l];                                                        \
+		}                                                                              \
+	}                                                                                  \
+	return bestd;                                                                      \
+}                                                                                      \
+                                                                                       \
+/* Smallest epsilon value needed by a vector to weakly dominate (see epsilon_pair) one \
+ * of the vectors j0..j1-1 of B */                                                     \
+static target double epsilon##sfx(const soafront_t *B, int j0, int j1,                 \
+		const double *a, epsilon_t method)                                             \
+{                                                                                      \
+	int j, k, l;                                                                       \
+	double res;                                                                        \
+	soa_vec##sfx c, t, e, m;                                                           \
+	soa_mask##sfx sel;                                                                 \
+                                                                                       \
+	m = (soa_vec##sfx){} + DBL_MAX;                                                    \
+	for (j = j0; j < j1; j += lanes)                                                   \
+	{                                                                                  \
+		e = (soa_vec##sfx){} - DBL_MAX;                                                \
+		for (k = 0; k < B->vlen; k++)                                                  \
+		{                                                                              \
+			__builtin_memcpy(&c, soafront_column(B, k) + j, sizeof(c));                \
+			t = (method == additive_e) ? c - a[k] : c / a[k];                          \
+			sel = (e < t);                                                             \
+			e = SOA_SELECT(soa_mask##sfx, sel, t, e);                                  \
+		}                                                                              \
+		sel = (e < m);                                                                 \
+		m = SOA_SELECT(soa_mask##sfx, sel, e, m);                                      \
+	}                                                                                  \
+	res = m[0];                                                                        \
+	for (l = 1; l < lanes; l++)                                                        \
+		res = (m[l] < res) ? m[l] : res;                                               \
+	return res;                                                                        \
+}                                                                                      \
+                                                                                       \
+static const soa_kernels kernels##sfx = {&bounds##sfx, &dominance##sfx, &nearest##sfx, \
+		&epsilon##sfx};
+
+SOA_KERNELS(_generic, , 2)
+#if MOO_ISA_VARIANTS
+SOA_KERNELS(_avx2, MOO_TARGET_AVX2, 4)
+SOA_KERNELS(_avx512, MOO_TARGET_AVX512, 8)
+#endif
+
+static const soa_kernels *select_kernels(void)
+{
+#if MOO_ISA_VARIANTS
+	switch (moo_active_isa())
+	{
+		case moo_isa_avx512:
+			return &kernels_avx512;
+		case moo_isa_avx2:
+			return &kernels_avx2;
+		default:
+			break;
+	}
+#endif
+	return &kernels_generic;
+}
+
+static soafront_t *new_soafront(int len, int vlen)
+{
+	size_t size;
+	soafront_t *S;
+
+	S = malloc(sizeof(soafront_t));
+	if (S)
+	{
+		S->len = len;
+		S->vlen = vlen;
+		S->stride = (len + SOAFRONT_PAD - 1) / SOAFRONT_PAD * SOAFRONT_PAD;
+		// A multiple of the alignment, as aligned_alloc requires
+		size = sizeof(double)*(size_t)vlen*S->stride;
+		S->data = aligned_alloc(SOAFRONT_ALIGN, size ? size : SOAFRONT_ALIGN);
+	}
+	if (!S || !S->data)
+	{
+		perror("MOOUtils: Out of memory when building columnar front");
+		exit(EXIT_FAILURE);
+	}
+	return S;
+}
+
+soafront_t *soafront_from_view(const frontview_t *set)
+{
+	int i, k;
+	double *col;
+	soafront_t *S = new_soafront(set->len, set->vlen);
+
+	for (k = 0; k < S->vlen; k++)
+	{
+		col = soafront_column(S, k);
+		for (i = 0; i < S->len; i++)
+			col[i] = frontview_at(set, i, k);
+		for (; i < S->stride; i++)
+			col[i] = col[S->len - 1];
+	}
+	return S;
+}
+
+soafront_t *soafront_from_matrix(double **set, int setlen, int vlen)
+{
+	frontview_t view = frontview_matrix(set, setlen, vlen);
+	return soafront_from_view(&view);
+}
+
+double **soafront_to_matrix(const soafront_t *S)
+{
+	int i, k;
+	double **set = new_matrix_double(S->len, S->vlen);
+
+	for (k = 0; k < S->vlen; k++)
+		for (i = 0; i < S->len; i++)
+			set[i][k] = soafront_column(S, k)[i];
+	return set;
+}
+
+frontview_t soafront_view(const soafront_t *S)
+{
+	return frontview_strided(S->data, S->len, S->vlen, 1, S->stride);
+}
+
+int soafront_dominance(const soafront_t *S, const double *x, signed char *out)
+{
+	return select_kernels()->dominance(S, x, out);
+}
+
+void soafront_nearest_squared_dists(const soafront_t *Y, const frontview_t *X,
+		const double *scale, double *dists, int *nearest)
+{
+	int i, best;
+	const soa_kernels *K = select_kernels();
+
+	for (i = 0; i < X->len; i++)
+	{
+		if (Y->len == 0)
+		{
+			dists[i] = DBL_MAX;
+			best = -1;
+		}
+		else
+			dists[i] = K->nearest(Y, frontview_row(X, i), X->cstride, scale, &best);
+		if (nearest)
+			nearest[i] = best;
+	}
+}
+
+void soafront_bounds(const soafront_t *S, double *min_values, double *max_values)
+{
+	int k;
+	const soa_kernels *K = select_kernels();
+
+	for (k = 0; k < S->vlen; k++)
+	{
+		if (S->len == 0)
+		{
+			min_values[k] = DBL_MAX;
+			max_values[k] = -DBL_MAX;
+		}
+		else
+			K->bounds(soafront_column(S, k), S->stride, &min_values[k], &max_values[k]);
+	}
+}
+
+/* Same check as epsilon_view's for the multiplicative indicator, through the views of
+ * the columns */
+static void check_multiplicative(const soafront_t *A, const soafront_t *B)
+{
+	frontview_t a = soafront_view(A), b = soafront_view(B);
+
+	if (!epsilon_valid_multiplicative(&a, &b))
+	{
+		perror("MOOUtils: Error in data.");
+		exit(EXIT_FAILURE);
+	}
+}
+
+double soafront_epsilon(const soafront_t *A, const soafront_t *B, epsilon_t method)
+{
+	int i, k, j0, j1, have_eps;
+	double eps, eps_j, m, a[A->vlen > 0 ? A->vlen : 1];
+	const soa_kernels *K = select_kernels();
+
+	switch (method)
+	{
+		case additive_e:
+			eps = DBL_MIN;
+			break;
+		case multiplicative_e:
+			eps = 0;
+			if (A->len > 0 && B->len > 0)
+				check_multiplicative(A, B);
+			break;
+		default:
+			perror("MOOUtils: Invalid option.");
+			exit(EXIT_FAILURE);
+	}
+	if (B->len == 0)
+		return (A->len > 0) ? 0 : eps;
+
+	// eps = max over A of (min over B of (max over the objectives)), as in epsilon_view
+	have_eps = 0;
+	for (i = 0; i < A->len; i++)
+	{
+		for (k = 0; k < A->vlen; k++)
+			a[k] = soafront_column(A, k)[i];
+		eps_j = DBL_MAX;
+		for (j0 = 0; j0 < B->stride; j0 = j1)
+		{
+			j1 = (B->stride - j0 < SOAFRONT_CHUNK) ? B->stride : j0 + SOAFRONT_CHUNK;
+			m = K->epsilon(B, j0, j1, a, method);
+			if (m < eps_j)
+				eps_j = m;
+			if (have_eps && eps_j <= eps)
+				break;
+		}
+		if (!have_eps || eps < eps_j)
+			eps = eps_j;
+		have_eps = 1;
+	}
+	return eps;
+}
+
+void free_soafront(soafront_t *S)
+{
+	if (!S)
+		return;
+	free(S->data);
+	free(S);
+}
@@ -0,0 +1,139 @@
+/*
+ * suite.c
+ *
+ * Combined evaluation of the quality indicators. Calling the indicators one after
+ * another repeats the normalization of the fronts and the nearest vector searches
+ * for every one of them; here that work is done once and shared.
+ *
+ *  Created on: 19/10/2026
+ *      Author: Miguel A. Ramiro <mike.longbow@gmail.com>
+ *  Copyright (c) 2014 Miguel A. Ramiro
+ *
+ *  This file is part of MOOUtils.
+ *
+ *  MOOUtils is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  MOOUtils is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MOOUtils.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "memalloc.h"
+#include "frontview.h"
+#include "moutils.h"
+#include "nearest.h"
+#include "reffront.h"
+#include "gamma.h"
+#include "delta.h"
+#include "epsilon.h"
+#include "suite.h"
+
+/* Shared body of indicator_suite_view and indicator_suite_ref. R is the prepared true
+ * front, or NULL if truefront and scale are given as they are. */
+static void suite_body(const frontview_t *front, const frontview_t *truefront,
+		const double *scale, const reffront_t *R, int mask, indicator_results_t *results)
+{
+	int i;
+	double sum;
+	double *dists;
+	int *nearest;
+
+	results->computed = 0;
+	if (front->vlen != 2)
+		mask &= ~INDICATOR_SPREAD;
+
+	/* Shared search of the nearest vector of the true front to each vector of the set.
+	 * GD is the sum of those distances, and for both epsilons the nearest vector is a
+	 * good enough guess to discard most of the set without any further search. */
+	dists = NULL;
+	nearest = NULL;
+	if (mask & (INDICATOR_GD | INDICATOR_EPSILON_ADD | INDICATOR_EPSILON_MUL))
+	{
+		dists = new_vector_double(front->len);
+		nearest = new_vector_int(front->len);
+		if (R)
+			reffront_nearest_squared_dists(R, front, 0, dists, nearest);
+		else
+			nearest_squared_dists(front, truefront, scale, 0, dists, nearest);
+	}
+
+	if (mask & INDICATOR_GD)
+	{
+		sum = 0;
+		for (i = 0; i < front->len; i++)
+			sum += dists[i];
+		results->gd = sqrt(sum)/front->len;
+	}
+	if (mask & INDICATOR_IGD)
+		results->igd = R ? inverted_generational_distance_ref(front, R) :
+				scaled_inverted_generational_distance_view(front, truefront, scale);
+	if (mask & INDICATOR_SPREAD)
+		results->spread = R ? spread_ref(front, R) :
+				scaled_spread_view(front, truefront, scale);
+	if (mask & INDICATOR_GSPREAD)
+		results->gspread = R ? generalized_spread_ref(front, R) :
+				scaled_generalized_spread_view(front, truefront, scale);
+	if (mask & INDICATOR_GSPREAD_ORIG)
+		results->gspread_orig = R ? generalized_spread_original_ref(front, R) :
+				scaled_generalized_spread_original_view(front, truefront, scale);
+	if (mask & INDICATOR_EPSILON_ADD)
+		results->epsilon_add = epsilon_view_hint(front, truefront, additive_e, nearest);
+	if (mask & INDICATOR_EPSILON_MUL)
+		results->epsilon_mul = epsilon_view_hint(front, truefront, multiplicative_e,
+				nearest);
+	results->computed = mask & INDICATOR_ALL;
+
+	if (dists)
+	{
+		free_vector(dists);
+		free_vector(nearest);
+	}
+}
+
+void indicator_suite_view(const frontview_t *front, const frontview_t *truefront,
+		int mask, indicator_results_t *results)
+{
+	double *scale;
+
+	// Shared normalization
+	scale = view_norm_scale(truefront);
+	suite_body(front, truefront, scale, NULL, mask, results);
+	free_vector(scale);
+}
+
+void indicator_suite_ref(const frontview_t *front, const reffront_t *truefront, int mask,
+		indicator_results_t *results)
+{
+	suite_body(front, &truefront->view, truefront->scale, truefront, mask, results);
+}
+
+int indicator_suite_check(const frontview_t *front, const reffront_t *truefront,
+		int mask)
+{
+	if (front->vlen != truefront->vlen)
+		return EVAL_EVLEN;
+	if (truefront->len == 0)
+		return EVAL_EDATA;
+	if ((mask & INDICATOR_EPSILON_MUL) &&
+			!epsilon_valid_multiplicative_ref(front, truefront))
+		return EVAL_EDATA;
+	return EVAL_OK;
+}
+
+void indicator_suite(double **front, int frontlen, double **truefront, int truefrontlen,
+		int vlen, int mask, indicator_results_t *results)
+{
+	frontview_t f = frontview_matrix(front, frontlen, vlen);
+	frontview_t t = frontview_matrix(truefront, truefrontlen, vlen);
+	indicator_suite_view(&f, &t, mask, results);
+}